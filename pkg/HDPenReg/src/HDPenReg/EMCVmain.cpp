@@ -26,6 +26,7 @@ RcppExport SEXP cvEMlassoMain( SEXP data, SEXP response
   vector<STK::Real> lambdaC = as<vector<STK::Real> >(lambda);
   //
   int p = dataC.sizeCols(), n = dataC.sizeRows();
+  //X is copied: the EM models work on a centered STK::ArrayXX, not on the buffer of R (see HDlars)
   ArrayXX x = dataC;
   VectorX y = responseC;
 
@@ -35,7 +36,8 @@ RcppExport SEXP cvEMlassoMain( SEXP data, SEXP response
   {
     mu = y.mean();
     y -= mu;
-    x -= STK::Const::Vector<STK::Real>(x.rows()) * STK::Stat::mean(x);
+    //the columns are centered in place, without a n*p temporary
+    for(int j = x.beginCols(); j < x.endCols(); j++) { x.col(j) -= x.col(j).mean();}
   }
 
   //if lambdaC[0]=-1, we have to generate the lambda sequence with the same way as the glmnet package
@@ -118,7 +120,8 @@ RcppExport SEXP cvEMfusedLasso1DMain( SEXP data, SEXP response
   {
     mu = y.mean();
     y -= mu;
-    x -= STK::Const::Vector<STK::Real>(x.rows()) * STK::Stat::mean(x);
+    //the columns are centered in place, without a n*p temporary
+    for(int j = x.beginCols(); j < x.endCols(); j++) { x.col(j) -= x.col(j).mean();}
   }
 
   //if lambda1 has to be optimized, we can generate the lambda1 sequence
@@ -205,7 +208,8 @@ RcppExport SEXP cvEMfusedLasso2DMain( SEXP data, SEXP response
   {
     mu = y.mean();
     y -= mu;
-    x -= STK::Const::Vector<STK::Real>(x.rows()) * STK::Stat::mean(x);
+    //the columns are centered in place, without a n*p temporary
+    for(int j = x.beginCols(); j < x.endCols(); j++) { x.col(j) -= x.col(j).mean();}
   }
 //  //if lambdaC[0]=-1, we have to generate the lambda sequence with the same way as the glmnet package
 //  if(lambda1C[0] == -1)
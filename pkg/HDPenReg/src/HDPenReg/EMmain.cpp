@@ -28,6 +28,7 @@ RcppExport SEXP EMlassoMain( SEXP data, SEXP response
   vector<STK::Real> lambdaC = as<vector<STK::Real> >(lambda);
   //
   int p = dataC.sizeCols(), n = dataC.sizeRows();
+  //X is copied: the EM models work on a centered STK::ArrayXX, not on the buffer of R (see HDlars)
   ArrayXX x = dataC;
   VectorX y = responseC;
   //center the data if intercept
@@ -36,7 +37,8 @@ RcppExport SEXP EMlassoMain( SEXP data, SEXP response
   {
     mu = y.mean();
     y -= mu;
-    x -= STK::Const::Vector<STK::Real>(x.rows()) * STK::Stat::mean(x);
+    //the columns are centered in place, without a n*p temporary
+    for(int j = x.beginCols(); j < x.endCols(); j++) { x.col(j) -= x.col(j).mean();}
   }
 
   // if lambdaC[0]=-1, we have to generate the lambda sequence in the same way
@@ -124,7 +126,8 @@ RcppExport SEXP EMfusedLassoMain( SEXP data, SEXP response
   {
     mu = y.mean();
     y -= mu;
-    x -= STK::Const::Vector<STK::Real>(x.rows()) * STK::Stat::mean(x);
+    //the columns are centered in place, without a n*p temporary
+    for(int j = x.beginCols(); j < x.endCols(); j++) { x.col(j) -= x.col(j).mean();}
   }
   //create EM
   EM algo(maxStepC,burnC,epsC);
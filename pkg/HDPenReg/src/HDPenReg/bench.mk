@@ -0,0 +1,62 @@
+## benchmarks of the lars and lassoModels libraries, not built with the R package
+## usage: make -f bench.mk HD_CPPFLAGS="..." HD_CXXFLAGS="..." BENCH_LIBS="..."
+## with the flags given by rtkore:::CppFlags(), rtkore:::CxxFlags() and rtkore:::LdFlags()
+## (add the OpenMP flag to HD_CXXFLAGS for the parallel cross validations)
+## The benchmarks write their results in JSON or CSV on the standard output, see bench/benchTools.h
+## The rule check builds and runs the checks of the lars library, it fails if one of them fails
+
+.PHONY: all bench check clean
+all:bench
+
+#-----------------------------------------------------------------------
+# Variables
+#
+LIBEM = ./lib/libEM.a
+LIBHD = ./lib/libHD.a
+BINDIR = ./bin
+
+#-----------------------------------------------------------------------
+# Sources files
+#
+SRCS =./bench/benchPathExtraction.cpp \
+			./bench/benchLars.cpp \
+			./bench/benchEM.cpp
+
+CHECK_SRCS =./bench/checkAllocations.cpp \
+			./bench/checkPath.cpp
+
+#-------------------------------------------------------------------------
+# generate the variables BINS and CHECKS containing the names of the executables
+#
+BINS= $(SRCS:./bench/%.cpp=$(BINDIR)/%)
+CHECKS= $(CHECK_SRCS:./bench/%.cpp=$(BINDIR)/%)
+
+#-------------------------------------------------------------------------
+# rule for building the executables
+#
+$(BINDIR)/%: ./bench/%.cpp ./bench/benchTools.h $(LIBEM)
+	$(CXX) $(HD_CXXFLAGS)  $(HD_CPPFLAGS) -DSTKBASEARRAYS=1  $< -o $@ $(LIBEM) $(BENCH_LIBS)
+
+# the lassoModels library uses the lars library, it is compiled with the default base of the arrays
+$(BINDIR)/benchEM: ./bench/benchEM.cpp ./bench/benchTools.h $(LIBHD) $(LIBEM)
+	$(CXX) $(HD_CXXFLAGS)  $(HD_CPPFLAGS) $< -o $@ $(LIBHD) $(LIBEM) $(BENCH_LIBS)
+
+$(LIBEM):
+	($(MAKE) -f lars.mk)
+
+$(LIBHD):
+	($(MAKE) -f lassoModels.mk)
+
+#-----------------------------------------------------------------------
+# The rule bench create the executables
+#
+bench: $(BINS)
+
+#-----------------------------------------------------------------------
+# The rule check runs the checks, they return a non zero status on failure
+#
+check: $(CHECKS)
+	@for c in $(CHECKS); do echo $$c; $$c || exit 1; done
+
+clean:
+	@-rm -f $(BINS) $(CHECKS)
@@ -0,0 +1,237 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file benchEM.cpp
+ *  @brief Benchmark of the lassoModels library (EM algorithms for the lasso,
+ *  the fused lasso and the logistic lasso, and their cross validations) on
+ *  simulated copy number data (see simulCN), over a grid of n, p, number of
+ *  causal segments and number of threads. The parameters of the algorithms
+ *  are the default values of the R functions EMlasso, EMfusedlasso,
+ *  EMcvlasso and EMcvfusedlasso. The data are centered as in EMmain.cpp.
+ *
+ *  benchmarks: emlasso, emlogistic, emfusedlasso, cvlasso, cvlogistic, cvfusedlasso
+ *
+ *  usage: benchEM [--n 200] [--p 2000] [--nbSeg 10] [--threads 1] [--repeats 3]
+ *                 [--seed 1] [--format json|csv] [--bench emlasso,cvlasso,...]
+ **/
+
+#include <cmath>
+#include "../lassoModels/EM.h"
+#include "../lassoModels/Lasso.h"
+#include "../lassoModels/FusedLasso.h"
+#include "../lassoModels/LogisticLasso.h"
+#include "../lassoModels/CVLasso.h"
+#include "../lassoModels/CVFusedLasso.h"
+#include "benchTools.h"
+
+using namespace STK;
+using namespace std;
+using namespace HD;
+
+/// number of values of lambda of a path
+static const int nbLambda = 20;
+/// number of folds of the cross validations
+static const int nbFolds = 5;
+/// maximal number of steps of the EM algorithm
+static const int maxSteps = 1000;
+/// burn period of the EM algorithm
+static const int burn = 50;
+/// threshold of convergence of the EM algorithm
+static const Real eps = 1e-5;
+/// threshold of the solvers (eps0 for the fused lasso)
+static const Real threshold = 1e-8;
+/// threshold of the conjugate gradient
+static const Real epsCG = 1e-8;
+
+/* decreasing sequence of lambda from the correlation max to a fraction of it, as in glmnet*/
+static vector<Real> lambdaSequence(ArrayXX const& x, VectorX const& y)
+{
+  int n = x.sizeRows(), p = x.sizeCols();
+  Real corrMax = (x.transpose() * y).abs().maxElt();
+  Real minLambda = corrMax * ((n < p) ? 0.01 : 0.0001);
+  Real gapLambda = (log(corrMax)-log(minLambda))/(nbLambda-1);
+  vector<Real> lambda(nbLambda);
+  lambda[0] = corrMax;
+  for(int i = 1; i < nbLambda; i++) { lambda[i] = exp(log(lambda[i-1]) - gapLambda);}
+  return lambda;
+}
+
+/* EM algorithm on a path of lambda, the path is stopped when all the coefficients are 0*/
+template<class LassoModel>
+static void benchEMLasso(BenchReport& report, ArrayXX const& x, VectorX const& y, vector<Real> const& lambda)
+{
+  Clock::time_point start = Clock::now();
+  EM algo(maxSteps, burn, eps);
+  LassoModel lasso(&x, &y, lambda[0], threshold, epsCG);
+  int nbSteps = 0, nbLambdaRun = 0;
+  for(int i = 0; i < (int) lambda.size(); i++)
+  {
+    lasso.setLambda(lambda[i]);
+    lasso.initializeBeta();
+    algo.run(&lasso);
+    nbSteps += algo.step();
+    nbLambdaRun++;
+    if(lasso.currentBeta().size() == 0) break;
+  }
+  report.add("time", elapsed(start));
+  report.add("steps", nbSteps);
+  report.add("lambda", nbLambdaRun);
+}
+
+/* EM algorithm for the fused lasso with a single pair (lambda1, lambda2)*/
+static void benchEMFusedLasso(BenchReport& report, ArrayXX const& x, VectorX const& y, Real lambda1, Real lambda2)
+{
+  Clock::time_point start = Clock::now();
+  EM algo(maxSteps, burn, eps);
+  FusedLasso fusedlasso(&x, &y, lambda1, lambda2, threshold, epsCG);
+  algo.run(&fusedlasso);
+  report.add("time", elapsed(start));
+  report.add("steps", algo.step());
+}
+
+/* cross validation of the lasso or of the logistic lasso, folds run in parallel*/
+template<class LassoModel>
+static void benchCVLasso( BenchReport& report, ArrayXX const& x, VectorX const& y, vector<Real> const& lambda
+                        , IMeasure* p_measure, unsigned long seed)
+{
+  Clock::time_point start = Clock::now();
+  CVLasso<LassoModel> lassocv;
+  lassocv.setX(x);
+  lassocv.setY(y);
+  lassocv.setNbFolds(nbFolds);
+  lassocv.setIndex(lambda);
+  lassocv.setBurn(burn);
+  lassocv.setMaxStep(maxSteps);
+  lassocv.setEps(eps);
+  lassocv.setEpsCG(epsCG);
+  lassocv.setThreshold(threshold);
+  lassocv.setTypeMeasure(p_measure);
+  lassocv.setSeed(seed);
+  lassocv.initialize();
+  lassocv.run2();
+  report.add("time", elapsed(start));
+  report.add("minCv", lassocv.cv().minElt());
+}
+
+/* cross validation of the fused lasso on lambda1, lambda2 being fixed*/
+static void benchCVFusedLasso( BenchReport& report, ArrayXX const& x, VectorX const& y, vector<Real> const& lambda1
+                             , Real lambda2, unsigned long seed)
+{
+  Clock::time_point start = Clock::now();
+  CVFusedLasso1D<FusedLasso> fusedlassocv;
+  Residuals measure;
+  fusedlassocv.setX(x);
+  fusedlassocv.setY(y);
+  fusedlassocv.setNbFolds(nbFolds);
+  fusedlassocv.setIndex(lambda1);
+  fusedlassocv.setOptimL1(true);
+  fusedlassocv.setLambda(lambda2);
+  fusedlassocv.setBurn(burn);
+  fusedlassocv.setEps(eps);
+  fusedlassocv.setMaxStep(maxSteps);
+  fusedlassocv.setThreshold(threshold);
+  fusedlassocv.setEpsCG(epsCG);
+  fusedlassocv.setTypeMeasure(&measure);
+  fusedlassocv.setSeed(seed);
+  fusedlassocv.initialize();
+  fusedlassocv.run2();
+  report.add("time", elapsed(start));
+  report.add("minCv", fusedlassocv.cv().minElt());
+}
+
+int main(int argc, char** argv)
+{
+  BenchOptions options;
+  if(!options.parse(argc, argv))
+  {
+    fprintf(stderr, "usage: benchEM [--n 200] [--p 2000] [--nbSeg 10] [--threads 1] [--repeats 3] [--seed 1] [--format json|csv] [--bench emlasso,cvlasso,...]\n");
+    return 1;
+  }
+  BenchReport report(options.csv);
+  SimulParameters param;
+  ArrayXX x, xc;
+  VectorX y, yc;
+  vector<int> causalSNP;
+  Residuals residuals;
+  AUC auc;
+  for(size_t in = 0; in < options.n.size(); in++)
+  for(size_t ip = 0; ip < options.p.size(); ip++)
+  for(size_t is = 0; is < options.nbSeg.size(); is++)
+  for(int r = 0; r < options.nbRepeats; r++)
+  {
+    int n = options.n[in], p = options.p[ip], nbSeg = options.nbSeg[is];
+    simulCN(n, p, nbSeg, param, options.seed + r, x, y, causalSNP);
+    //the linear models are run on centered data, the logistic models on the raw data
+    xc = x;
+    yc = y;
+    yc -= yc.mean();
+    for(int j = xc.beginCols(); j < xc.endCols(); j++) { xc.col(j) -= xc.col(j).mean();}
+    vector<Real> lambda = lambdaSequence(xc, yc), lambdaLogistic = lambdaSequence(x, y);
+    //the fused lasso is run with the middle of the path for lambda1 and lambda2
+    Real lambdaFused = lambda[nbLambda/2];
+    for(size_t it = 0; it < options.threads.size(); it++)
+    {
+      int threads = setThreads(options.threads[it]);
+      if(options.isSelected("emlasso"))
+      {
+        benchEMLasso<Lasso>(report, xc, yc, lambda);
+        report.write("emlasso", "linear", n, p, nbSeg, threads, r);
+      }
+      if(options.isSelected("emlogistic"))
+      {
+        benchEMLasso<LogisticLasso>(report, x, y, lambdaLogistic);
+        report.write("emlasso", "logistic", n, p, nbSeg, threads, r);
+      }
+      if(options.isSelected("emfusedlasso"))
+      {
+        benchEMFusedLasso(report, xc, yc, lambdaFused, lambdaFused);
+        report.write("emfusedlasso", "linear", n, p, nbSeg, threads, r);
+      }
+      if(options.isSelected("cvlasso"))
+      {
+        benchCVLasso<Lasso>(report, xc, yc, lambda, &residuals, options.seed + r);
+        report.write("cvlasso", "linear", n, p, nbSeg, threads, r);
+      }
+      if(options.isSelected("cvlogistic"))
+      {
+        benchCVLasso<LogisticLasso>(report, x, y, lambdaLogistic, &auc, options.seed + r);
+        report.write("cvlasso", "logistic", n, p, nbSeg, threads, r);
+      }
+      if(options.isSelected("cvfusedlasso"))
+      {
+        benchCVFusedLasso(report, xc, yc, lambda, lambdaFused, options.seed + r);
+        report.write("cvfusedlasso", "linear", n, p, nbSeg, threads, r);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,382 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file benchLars.cpp
+ *  @brief Benchmark of the lars library (Lars, Fusion and Cvlars) on simulated
+ *  copy number data (see simulCN), over a grid of n, p, number of causal
+ *  segments and number of threads. The time of each run is given with the
+ *  timings of the phases of the algorithm (see Timings).
+ *
+ *  benchmarks: lars, larsCholesky, larsGram, larsCache, fusion, cvlars, cvlarsGram, multilars
+ *
+ *  multilars runs MultiLars on several responses (the simulated status and copies of it
+ *  with a part of the status changed), and the lars algorithm on each response separately.
+ *
+ *  storages of the design: dense (STK::CArrayXX), buffer (BufferDesign on the memory of
+ *  the array), float (FloatDesign), sparse (SparseDesign), genotype (GenotypeDesign, the
+ *  values are rounded to 0, 1 or 2), mapped (MappedDesign on a file written by the
+ *  benchmark). The values of the simulated design are set to zero with the probability
+ *  1-density (see sparsify) and all the storages are run on the same design.
+ *
+ *  The design is made of nbBlocks blocks of p variables: the first block is simulated with
+ *  the response, the others with their own seed and have no effect on the response. The
+ *  mapped design is written block by block, so with the storage mapped alone the file can
+ *  be larger than the memory. A file smaller than the memory is in the cache of the system
+ *  after its writing, empty the cache before the runs for the time of the reads on the disk.
+ *
+ *  usage: benchLars [--n 200] [--p 2000] [--nbSeg 10] [--threads 1] [--repeats 3]
+ *                   [--seed 1] [--format json|csv] [--bench lars,fusion,...]
+ *                   [--storage dense,buffer,float,sparse,genotype,mapped] [--density 1,0.1,0.01]
+ *                   [--blocks 1] [--file bench.bin]
+ **/
+
+#include "../larsRmain.h"
+#include "benchTools.h"
+
+using namespace STK;
+using namespace std;
+using namespace HD;
+
+/// number of folds of the cross validation
+static const int nbFolds = 5;
+/// threshold of the lars algorithm, as in HDlars
+static const Real eps = 1e-8;
+/// number of responses of the multilars benchmark
+static const int nbResponses = 4;
+/// proportion of the status changed in each additional response of the multilars benchmark
+static const double probChange = 0.2;
+
+/* add the timings and counters of a lars, fusion or cvlars object to the result*/
+static void addTimings(BenchReport& report, Timings const& timings)
+{
+  for(int i = 0; i < Timings::nbPhase; i++)
+  {
+    Timings::Phase phase = static_cast<Timings::Phase>(i);
+    report.add(string("time.") + Timings::name(phase), timings.time(phase));
+  }
+  report.add("add", timings.nbAdd());
+  report.add("drop", timings.nbDrop());
+  report.add("ignored", timings.nbIgnore());
+}
+
+/* @return true if storage is the name of a storage of the design*/
+static bool isStorage(string const& storage)
+{
+  return storage == "dense" || storage == "buffer" || storage == "float" || storage == "sparse"
+      || storage == "genotype" || storage == "mapped";
+}
+
+/* append the columns of X to a file, in double precision
+ * @return false if the file cannot be written
+ */
+static bool writeColumns(FILE* file, CArrayXX const& X)
+{
+  for(int j = X.beginCols(); j < X.endCols(); j++)
+  {
+    if(fwrite(&X(X.beginRows(),j), sizeof(Real), X.sizeRows(), file) != (size_t) X.sizeRows())
+      return false;
+  }
+  return true;
+}
+
+/* create the design of a storage other than dense from X
+ * @param n number of individuals
+ * @param fileName file of the mapped storage, written by the caller. X is not used for this storage.
+ * @return the design, 0 if the storage is unknown
+ */
+static IDesign* createDesign(string const& storage, CArrayXX const& X, int n, string const& fileName)
+{
+  if(storage == "mapped") { return new MappedDesign(fileName, n);}
+  if(storage == "buffer") { return new BufferDesign(&X(X.beginRows(),X.beginCols()), X.sizeRows(), X.sizeCols());}
+  if(storage == "float") { return new FloatDesign(X);}
+  if(storage == "genotype")
+  {
+    CArrayXX G(Range(1,X.sizeRows()), Range(1,X.sizeCols()));
+    for(int j = 1; j <= X.sizeCols(); j++)
+      for(int i = 1; i <= X.sizeRows(); i++)
+        G(i,j) = min(2., max(0., (Real) (int) (X(X.beginRows()+i-1, X.beginCols()+j-1) + 0.5)));
+    return new GenotypeDesign(G);
+  }
+  if(storage == "sparse")
+  {
+    //column compressed storage (index from 0) of the non-zero values, as a dgCMatrix
+    vector<int> colPtr(1, 0), rowIdx;
+    vector<double> values;
+    for(int j = X.beginCols(); j < X.endCols(); j++)
+    {
+      for(int i = X.beginRows(); i < X.endRows(); i++)
+        if(X(i,j) != 0.)
+        {
+          rowIdx.push_back(i - X.beginRows());
+          values.push_back(X(i,j));
+        }
+      colPtr.push_back(values.size());
+    }
+    return new SparseDesign( X.sizeRows(), X.sizeCols(), &colPtr[0]
+                           , rowIdx.empty() ? 0 : &rowIdx[0], values.empty() ? 0 : &values[0]);
+  }
+  return 0;
+}
+
+/* run the lars algorithm
+ * @param mode 0: QR, 1: Cholesky, 2: Gram matrix, 3: cache of the X'X columns
+ */
+template<class Design>
+static void benchLars(BenchReport& report, Design const& X, CVectorX const& y, int mode)
+{
+  int maxSteps = 3*min(X.sizeRows(), X.sizeCols());
+  Clock::time_point start = Clock::now();
+  Lars lars(X, y, maxSteps, true, eps, mode == 2, (mode == 3) ? 100. : 0.);
+  lars.setCholesky(mode == 1);
+  lars.run();
+  report.add("time", elapsed(start));
+  report.add("steps", lars.step());
+  addTimings(report, lars.timings());
+}
+
+/* run the fusion algorithm*/
+template<class Design>
+static void benchFusion(BenchReport& report, Design const& X, CVectorX const& y)
+{
+  int maxSteps = 3*min(X.sizeRows(), X.sizeCols());
+  Clock::time_point start = Clock::now();
+  Fusion fusion(X, y, maxSteps, true, eps);
+  fusion.run();
+  report.add("time", elapsed(start));
+  report.add("steps", fusion.step());
+  addTimings(report, fusion.timings());
+}
+
+/* run the cross validation of the lars algorithm, in parallel when OpenMP is available. The
+ * partition is drawn from seed, so the results do not depend on the time of the run*/
+/* run MultiLars on the responses Y, or the lars algorithm on each response if isMulti is false*/
+static void benchMultiLars(BenchReport& report, IDesign const& X, CArrayXX const& Y, bool isMulti)
+{
+  int maxSteps = 3*min(X.sizeRows(), X.sizeCols()), nbSteps = 0;
+  Timings timings;
+  Clock::time_point start = Clock::now();
+  if(isMulti)
+  {
+    MultiLars multiLars(X, Y, maxSteps, true, eps);
+    multiLars.run();
+    for(int k = 0; k < multiLars.nbResponse(); k++)
+    {
+      nbSteps += multiLars.lars(k).step();
+      timings += multiLars.lars(k).timings();
+    }
+  }
+  else
+  {
+    CVectorX y(Range(1,X.sizeRows()));
+    for(int k = Y.beginCols(); k < Y.endCols(); k++)
+    {
+      for(int i = Y.beginRows(), iy = y.begin(); i < Y.endRows(); i++, iy++) { y[iy] = Y(i,k);}
+      Lars lars(X, y, maxSteps, true, eps);
+      lars.run();
+      nbSteps += lars.step();
+      timings += lars.timings();
+    }
+  }
+  report.add("time", elapsed(start));
+  report.add("steps", nbSteps);
+  addTimings(report, timings);
+}
+
+/* MultiLars takes a design: the array is used through an ArrayDesign*/
+static void benchMultiLars(BenchReport& report, CArrayXX const& X, CArrayXX const& Y, bool isMulti)
+{
+  ArrayDesign design(X);
+  benchMultiLars(report, design, Y, isMulti);
+}
+
+/* create the responses of the multilars benchmark: y and copies of y with a part of the status changed
+ * @param seed seed of the generator
+ */
+static void createResponses(CVectorX const& y, unsigned long seed, CArrayXX& Y)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> unif(0., 1.);
+  Y.resize(Range(1,y.size()), Range(1,nbResponses));
+  for(int k = 1; k <= nbResponses; k++)
+    for(int i = 1, iy = y.begin(); i <= y.size(); i++, iy++)
+      Y(i,k) = (k > 1 && unif(generator) < probChange) ? 1. - y[iy] : y[iy];
+}
+
+template<class Design>
+static void benchCvlars(BenchReport& report, Design const& X, CVectorX const& y, bool useGram, unsigned long seed)
+{
+  int maxSteps = 3*min(X.sizeRows(), X.sizeCols());
+  Clock::time_point start = Clock::now();
+  Cvlars cvlars(X, y, nbFolds, maxSteps, true, eps);
+  cvlars.setRepeats(1, seed);
+  cvlars.setGram(useGram);
+#ifdef _OPENMP
+  cvlars.run2();
+#else
+  cvlars.run();
+#endif
+  report.add("time", elapsed(start));
+  report.add("minCv", cvlars.cv().minElt());
+  addTimings(report, cvlars.timings());
+}
+
+/* run the selected benchmarks on the design X*/
+template<class Design>
+static void benchAll( BenchReport& report, BenchOptions const& options, Design const& X, CVectorX const& y
+                    , CArrayXX const& Y, int nbSeg, int threads, int r)
+{
+  int n = X.sizeRows(), p = X.sizeCols();
+  if(options.isSelected("lars"))
+  {
+    benchLars(report, X, y, 0);
+    report.write("lars", "qr", n, p, nbSeg, threads, r);
+  }
+  if(options.isSelected("larsCholesky"))
+  {
+    benchLars(report, X, y, 1);
+    report.write("lars", "cholesky", n, p, nbSeg, threads, r);
+  }
+  if(options.isSelected("larsGram"))
+  {
+    benchLars(report, X, y, 2);
+    report.write("lars", "gram", n, p, nbSeg, threads, r);
+  }
+  if(options.isSelected("larsCache"))
+  {
+    benchLars(report, X, y, 3);
+    report.write("lars", "cache", n, p, nbSeg, threads, r);
+  }
+  if(options.isSelected("fusion"))
+  {
+    benchFusion(report, X, y);
+    report.write("fusion", "qr", n, p, nbSeg, threads, r);
+  }
+  if(options.isSelected("cvlars"))
+  {
+    benchCvlars(report, X, y, false, options.seed + r);
+    report.write("cvlars", "qr", n, p, nbSeg, threads, r);
+  }
+  if(options.isSelected("cvlarsGram"))
+  {
+    benchCvlars(report, X, y, true, options.seed + r);
+    report.write("cvlars", "gram", n, p, nbSeg, threads, r);
+  }
+  if(options.isSelected("multilars"))
+  {
+    benchMultiLars(report, X, Y, true);
+    report.write("multilars", "multi", n, p, nbSeg, threads, r);
+    benchMultiLars(report, X, Y, false);
+    report.write("multilars", "separate", n, p, nbSeg, threads, r);
+  }
+}
+
+static void usage()
+{
+  fprintf(stderr, "usage: benchLars [--n 200] [--p 2000] [--nbSeg 10] [--threads 1] [--repeats 3] [--seed 1] [--format json|csv] [--bench lars,fusion,...] [--storage dense,buffer,float,sparse,genotype,mapped] [--density 1,0.1,0.01] [--blocks 1] [--file bench.bin]\n");
+}
+
+int main(int argc, char** argv)
+{
+  BenchOptions options;
+  if(!options.parse(argc, argv))
+  {
+    usage();
+    return 1;
+  }
+  for(size_t is = 0; is < options.storage.size(); is++)
+  {
+    if(!isStorage(options.storage[is]))
+    {
+      fprintf(stderr, "unknown storage %s\n", options.storage[is].c_str());
+      usage();
+      return 1;
+    }
+  }
+  //the design is kept in memory only if a storage other than mapped is run
+  bool isMapped = false, inMemory = false;
+  for(size_t is = 0; is < options.storage.size(); is++)
+  {
+    if(options.storage[is] == "mapped") { isMapped = true;}
+    else { inMemory = true;}
+  }
+  BenchReport report(options.csv);
+  SimulParameters param;
+  CArrayXX X, Xb, Y;
+  CVectorX y, yb;
+  vector<int> causalSNP;
+  for(size_t in = 0; in < options.n.size(); in++)
+  for(size_t ip = 0; ip < options.p.size(); ip++)
+  for(size_t is = 0; is < options.nbSeg.size(); is++)
+  for(int r = 0; r < options.nbRepeats; r++)
+  for(size_t id = 0; id < options.density.size(); id++)
+  {
+    int n = options.n[in], p = options.p[ip], nbSeg = options.nbSeg[is];
+    if(inMemory) { X.resize(Range(1,n), Range(1,options.nbBlocks*p));}
+    FILE* file = isMapped ? fopen(options.fileName.c_str(), "wb") : 0;
+    bool isWritten = !isMapped || file;
+    for(int b = 0; b < options.nbBlocks && isWritten; b++)
+    {
+      //the seed of a block does not depend on the other points of the grid
+      unsigned long seed = options.seed + r + (unsigned long) b * options.nbRepeats;
+      simulCN(n, p, nbSeg, param, seed, Xb, (b == 0) ? y : yb, causalSNP);
+      sparsify(options.density[id], seed, Xb);
+      if(inMemory)
+      {
+        for(int j = 1; j <= p; j++)
+          for(int i = 1; i <= n; i++) { X(i, b*p+j) = Xb(i,j);}
+      }
+      if(file) { isWritten = writeColumns(file, Xb);}
+    }
+    if(file && fclose(file) != 0) { isWritten = false;}
+    if(!isWritten)
+    {
+      fprintf(stderr, "cannot write the file %s\n", options.fileName.c_str());
+      return 1;
+    }
+    if(options.isSelected("multilars")) { createResponses(y, options.seed + r, Y);}
+    for(size_t ist = 0; ist < options.storage.size(); ist++)
+    {
+      string const& storage = options.storage[ist];
+      IDesign* p_design = (storage == "dense") ? 0 : createDesign(storage, X, n, options.fileName);
+      report.setDesign(storage, options.density[id]);
+      for(size_t it = 0; it < options.threads.size(); it++)
+      {
+        int threads = setThreads(options.threads[it]);
+        if(p_design) { benchAll(report, options, *p_design, y, Y, nbSeg, threads, r);}
+        else { benchAll(report, options, X, y, Y, nbSeg, threads, r);}
+      }
+      delete p_design;
+    }
+    if(isMapped) { remove(options.fileName.c_str());}
+  }
+  return 0;
+}
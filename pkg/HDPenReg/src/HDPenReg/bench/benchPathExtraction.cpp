@@ -0,0 +1,129 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file benchPathExtraction.cpp
+ *  @brief Benchmark of the extraction of a long lars path, timed separately
+ *  from the fit. The flat extraction used by the R bridge (Path::copyStates and
+ *  Path::copyEvolution in arrays allocated once) is compared with the former
+ *  extraction in a vector of vectors by state.
+ *
+ *  usage: benchPathExtraction [n] [p] [maxSteps] [seed]
+ **/
+
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <random>
+#include "../larsRmain.h"
+
+using namespace STK;
+using namespace std;
+using namespace HD;
+
+typedef chrono::steady_clock Clock;
+
+/* @return elapsed time in seconds since start*/
+static double elapsed(Clock::time_point const& start)
+{ return chrono::duration<double>(Clock::now() - start).count();}
+
+/* extraction in arrays allocated once, as done in wrapPath*/
+static size_t flatExtraction(Path const& path)
+{
+  vector<int> stateBegin(path.size()+1), varIdx(path.nbCoefficients());
+  vector<Real> varCoeff(path.nbCoefficients()), l1norm(path.size());
+  vector<int> addBegin(path.size()), addIdx(path.nbAddEvents());
+  vector<int> dropBegin(path.size()), dropIdx(path.nbDropEvents());
+  path.copyStates(&stateBegin[0], varIdx.empty() ? 0 : &varIdx[0], varCoeff.empty() ? 0 : &varCoeff[0], &l1norm[0]);
+  path.copyEvolution(&addBegin[0], addIdx.empty() ? 0 : &addIdx[0], &dropBegin[0], dropIdx.empty() ? 0 : &dropIdx[0]);
+  return varIdx.size() + addIdx.size() + dropIdx.size();
+}
+
+/* former extraction: a vector by state and the whole evolution copied twice by step*/
+static size_t nestedExtraction(Lars const& lars)
+{
+  int step = lars.step();
+  vector<vector<int> > varIdx(step+1), evoIdxAdd(step), evoIdxDrop(step);
+  vector<vector<Real> > varCoeff(step+1);
+  size_t size = 0;
+  for(int i = 1; i <= step; i++)
+  {
+    varIdx[i].resize(lars.path(i).size());
+    varCoeff[i].resize(lars.path(i).size());
+    for(int j = 1; j <= lars.path(i).size(); j++)
+    {
+      varCoeff[i][j-1] = lars.coefficient(i,j);
+      varIdx[i][j-1] = lars.varIdx(i,j);
+    }
+    evoIdxAdd[i-1] = lars.evolution()[i-1].first;
+    evoIdxDrop[i-1] = lars.evolution()[i-1].second;
+    size += varIdx[i].size() + evoIdxAdd[i-1].size() + evoIdxDrop[i-1].size();
+  }
+  return size;
+}
+
+int main(int argc, char** argv)
+{
+  int n = (argc > 1) ? atoi(argv[1]) : 3000;
+  int p = (argc > 2) ? atoi(argv[2]) : 3000;
+  int maxSteps = (argc > 3) ? atoi(argv[3]) : 5000;
+  int seed = (argc > 4) ? atoi(argv[4]) : 1;
+
+  //gaussian design, the response depends on 10 variables
+  mt19937 generator(seed);
+  normal_distribution<double> normal(0., 1.);
+  CArrayXX X(Range(1,n), Range(1,p));
+  CVectorX y(Range(1,n), 0.);
+  for(int j = 1; j <= p; j++)
+    for(int i = 1; i <= n; i++)
+      X(i,j) = normal(generator);
+  for(int i = 1; i <= n; i++)
+  {
+    for(int j = 1; j <= std::min(10,p); j++) { y[i] += X(i,j);}
+    y[i] += normal(generator);
+  }
+
+  Clock::time_point start = Clock::now();
+  Lars lars(X, y, maxSteps, true, 1e-8);
+  lars.run();
+  double tFit = elapsed(start);
+
+  start = Clock::now();
+  size_t flatSize = flatExtraction(lars.path());
+  double tFlat = elapsed(start);
+
+  start = Clock::now();
+  size_t nestedSize = nestedExtraction(lars);
+  double tNested = elapsed(start);
+
+  printf("{\"n\": %d, \"p\": %d, \"steps\": %d, \"values\": %lu, \"fit\": %g, \"flatExtraction\": %g, \"nestedExtraction\": %g}\n"
+        , n, p, lars.step(), (unsigned long) flatSize, tFit, tFlat, tNested);
+  return (flatSize == nestedSize) ? 0 : 1;
+}
@@ -0,0 +1,344 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file benchTools.h
+ *  @brief Tools shared by the benchmarks: simulation of copy number data as
+ *  the R function simul, grid of parameters given on the command line and
+ *  output of the results in JSON (one object by line) or in CSV.
+ *
+ *  options of the command line, the lists are separated by commas:
+ *  --n 100,500        number of individuals
+ *  --p 1000,10000     number of SNPs
+ *  --nbSeg 10         number of causal segments (sparsity)
+ *  --threads 1,4      number of threads (ignored without OpenMP)
+ *  --repeats 3        number of repeats of each point of the grid
+ *  --seed 1           seed of the simulations, the repeat r uses seed+r
+ *  --format json|csv  format of the output
+ *  --bench a,b        benchmarks to run, all by default
+ *  --storage a,b      storages of the design (dense, sparse...), see the benchmark
+ *  --density 1,0.1    proportion of non-zero values of the design (see sparsify)
+ *  --blocks 1         number of blocks of p variables of the design, each simulated with its own seed
+ *  --file name        file written for the designs mapped in memory
+ **/
+
+#ifndef BENCHTOOLS_H_
+#define BENCHTOOLS_H_
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace HD
+{
+typedef std::chrono::steady_clock Clock;
+
+/** @return elapsed time in seconds since start*/
+inline double elapsed(Clock::time_point const& start)
+{ return std::chrono::duration<double>(Clock::now() - start).count();}
+
+/**
+ * set the number of threads of the parallel regions
+ * @param nbThreads number of threads
+ * @return the number of threads really used (1 without OpenMP)
+ */
+inline int setThreads(int nbThreads)
+{
+#ifdef _OPENMP
+  omp_set_num_threads(nbThreads);
+  return nbThreads;
+#else
+  (void) nbThreads;
+  return 1;
+#endif
+}
+
+/**
+ * Parameters of the simulation of copy number data, with the default values of the examples of simul
+ */
+struct SimulParameters
+{
+  /// probability to be a case individual
+  double probCas;
+  /// mean size of an abnormal segment
+  int meanSegmentSize;
+  /// prob[y][0]: probability of an anomaly at a causal SNP, prob[y][1] at a non causal SNP, y = 0 for controls
+  double prob[2][2];
+  /// parameter of the beta(alpha,alpha) noise
+  double alpha;
+  SimulParameters() : probCas(0.4), meanSegmentSize(50), alpha(15.)
+  { prob[0][0] = 0.1; prob[0][1] = 0.02; prob[1][0] = 0.8; prob[1][1] = 0.02;}
+};
+
+/**
+ * draw a beta(alpha,alpha) as G1/(G1+G2) with G1, G2 gamma(alpha)
+ * @param generator random generator
+ * @param gamma gamma(alpha,1) distribution
+ */
+inline double drawBeta(std::mt19937& generator, std::gamma_distribution<double>& gamma)
+{
+  double g1 = gamma(generator), g2 = gamma(generator);
+  return g1/(g1+g2);
+}
+
+/**
+ * simulate copy number data for a case-control study as the R function simul: a normal signal
+ * 1.5+beta(alpha,alpha), and segments of gain (2.5) or loss (0.5) around the SNPs with an anomaly. The
+ * anomaly of a causal SNP has the same type for all the individuals.
+ * @param n number of individuals
+ * @param nbSNP number of SNPs
+ * @param nbSeg number of causal segments
+ * @param param parameters of the simulation
+ * @param seed seed of the generator
+ * @param X copy number signal of size n*nbSNP
+ * @param y case (1) or control (0) status of size n
+ * @param causalSNP center of the causal segments (from 1 to nbSNP), in increasing order
+ */
+template<class Array, class Vector>
+void simulCN( int n, int nbSNP, int nbSeg, SimulParameters const& param, unsigned long seed
+            , Array& X, Vector& y, std::vector<int>& causalSNP)
+{
+  std::mt19937 generator(seed);
+  std::gamma_distribution<double> gamma(param.alpha, 1.);
+  std::uniform_real_distribution<double> unif(0., 1.);
+  std::poisson_distribution<int> segSize(param.meanSegmentSize);
+  //choose the causal SNPs and the type of their anomaly
+  std::vector<int> snp(nbSNP);
+  for(int j = 0; j < nbSNP; j++) { snp[j] = j+1;}
+  for(int j = 0; j < nbSeg; j++)
+  { std::swap(snp[j], snp[j + (int) (unif(generator) * (nbSNP-j))]);}
+  causalSNP.assign(snp.begin(), snp.begin() + nbSeg);
+  std::sort(causalSNP.begin(), causalSNP.end());
+  std::vector<double> causalLevel(nbSeg);
+  for(int s = 0; s < nbSeg; s++) { causalLevel[s] = (unif(generator) < 0.5) ? 0.5 : 2.5;}
+  std::vector<int> causalRank(nbSNP+1, -1);
+  for(int s = 0; s < nbSeg; s++) { causalRank[causalSNP[s]] = s;}
+
+  //the arrays start at STK::baseIdx: 1 for the lars library, 0 for the lassoModels library
+  int b = STK::baseIdx;
+  X.resize(STK::Range(b,n), STK::Range(b,nbSNP));
+  y.resize(STK::Range(b,n));
+  for(int i = 0; i < n; i++) { y[b+i] = (unif(generator) < param.probCas) ? 1. : 0.;}
+  for(int j = 0; j < nbSNP; j++)
+    for(int i = 0; i < n; i++)
+      X(b+i,b+j) = drawBeta(generator, gamma) + 1.5;
+  for(int i = 0; i < n; i++)
+  {
+    int status = (int) y[b+i];
+    for(int j = 1; j <= nbSNP; j++)
+    {
+      bool isCausal = causalRank[j] >= 0;
+      if(unif(generator) >= param.prob[status][isCausal ? 0 : 1]) continue;
+      //segment centered on the SNP j
+      int size = std::max(1, segSize(generator));
+      double level = isCausal ? causalLevel[causalRank[j]] : ((unif(generator) < 0.5) ? 0.5 : 2.5);
+      for(int k = std::max(1, j - size/2); k <= std::min(nbSNP, j + size/2); k++)
+        X(b+i,b+k-1) = level + drawBeta(generator, gamma);
+    }
+  }
+}
+
+/**
+ * set to zero the values of X with probability 1-density, in order to get a sparse design
+ * with the structure of the simulated data
+ * @param density proportion of the values kept
+ * @param seed seed of the generator
+ * @param X design
+ */
+template<class Array>
+void sparsify(double density, unsigned long seed, Array& X)
+{
+  if(density >= 1.) return;
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> unif(0., 1.);
+  for(int j = X.beginCols(); j < X.endCols(); j++)
+    for(int i = X.beginRows(); i < X.endRows(); i++)
+      if(unif(generator) >= density) { X(i,j) = 0.;}
+}
+
+/**
+ * Grid of parameters of a benchmark, read on the command line
+ */
+struct BenchOptions
+{
+  /// numbers of individuals
+  std::vector<int> n;
+  /// numbers of SNPs
+  std::vector<int> p;
+  /// numbers of causal segments
+  std::vector<int> nbSeg;
+  /// numbers of threads
+  std::vector<int> threads;
+  /// number of repeats of each point of the grid
+  int nbRepeats;
+  /// seed of the simulations
+  unsigned long seed;
+  /// if true the results are written in CSV, else in JSON
+  bool csv;
+  /// benchmarks to run, empty for all
+  std::vector<std::string> bench;
+  /// storages of the design
+  std::vector<std::string> storage;
+  /// proportions of non-zero values of the design
+  std::vector<double> density;
+  /// number of blocks of p variables of the design
+  int nbBlocks;
+  /// file written for the designs mapped in memory
+  std::string fileName;
+
+  BenchOptions() : n(1,200), p(1,2000), nbSeg(1,10), threads(1,1), nbRepeats(3), seed(1), csv(false), bench()
+                 , storage(1,"dense"), density(1,1.), nbBlocks(1), fileName("bench.bin") {}
+
+  /** @return true if the benchmark name has to be run*/
+  bool isSelected(std::string const& name) const
+  { return bench.empty() || std::find(bench.begin(), bench.end(), name) != bench.end();}
+
+  /**
+   * read the options of the command line
+   * @return false if an option is unknown or has no value
+   */
+  bool parse(int argc, char** argv)
+  {
+    for(int i = 1; i < argc; i += 2)
+    {
+      if(i+1 >= argc) return false;
+      std::string option(argv[i]), value(argv[i+1]);
+      if(option == "--n") { n = toInt(split(value));}
+      else if(option == "--p") { p = toInt(split(value));}
+      else if(option == "--nbSeg") { nbSeg = toInt(split(value));}
+      else if(option == "--threads") { threads = toInt(split(value));}
+      else if(option == "--repeats") { nbRepeats = atoi(value.c_str());}
+      else if(option == "--seed") { seed = strtoul(value.c_str(), 0, 10);}
+      else if(option == "--format") { csv = (value == "csv");}
+      else if(option == "--bench") { bench = split(value);}
+      else if(option == "--storage") { storage = split(value);}
+      else if(option == "--density") { density = toDouble(split(value));}
+      else if(option == "--blocks") { nbBlocks = atoi(value.c_str());}
+      else if(option == "--file") { fileName = value;}
+      else return false;
+    }
+    return true;
+  }
+
+  private:
+    static std::vector<std::string> split(std::string const& value)
+    {
+      std::vector<std::string> items;
+      size_t begin = 0, end;
+      while((end = value.find(',', begin)) != std::string::npos)
+      {
+        items.push_back(value.substr(begin, end-begin));
+        begin = end+1;
+      }
+      items.push_back(value.substr(begin));
+      return items;
+    }
+    static std::vector<int> toInt(std::vector<std::string> const& items)
+    {
+      std::vector<int> values(items.size());
+      for(size_t i = 0; i < items.size(); i++) { values[i] = atoi(items[i].c_str());}
+      return values;
+    }
+    static std::vector<double> toDouble(std::vector<std::string> const& items)
+    {
+      std::vector<double> values(items.size());
+      for(size_t i = 0; i < items.size(); i++) { values[i] = atof(items[i].c_str());}
+      return values;
+    }
+};
+
+/**
+ * Output of the results on stdout. A result is a run of a benchmark at a point of the grid with a list
+ * of metrics (time in seconds, number of steps...). In JSON, a result is an object on one line; in CSV,
+ * a result takes a line by metric, in order to have the same columns for all the benchmarks. The storage
+ * and the density of the design are dense and 1 unless they are set with setDesign.
+ */
+class BenchReport
+{
+  public:
+    /**
+     * Constructor
+     * @param csv if true the results are written in CSV, else in JSON
+     */
+    BenchReport(bool csv) : csv_(csv), storage_("dense"), density_(1.), metrics_()
+    { if(csv_) { printf("benchmark,variant,storage,density,n,p,nbSeg,threads,repeat,metric,value\n");}}
+
+    /** set the storage and the density of the design of the next results*/
+    void setDesign(std::string const& storage, double density)
+    { storage_ = storage; density_ = density;}
+
+    /** add a metric to the current result*/
+    void add(std::string const& metric, double value)
+    { metrics_.push_back(std::make_pair(metric, value));}
+
+    /** write the current result and start a new one*/
+    void write( char const* benchmark, char const* variant, int n, int p, int nbSeg, int threads, int repeat)
+    {
+      if(csv_)
+      {
+        for(size_t m = 0; m < metrics_.size(); m++)
+          printf("%s,%s,%s,%g,%d,%d,%d,%d,%d,%s,%.9g\n", benchmark, variant, storage_.c_str(), density_
+                , n, p, nbSeg, threads, repeat, metrics_[m].first.c_str(), metrics_[m].second);
+      }
+      else
+      {
+        printf("{\"benchmark\": \"%s\", \"variant\": \"%s\", \"storage\": \"%s\", \"density\": %g, \"n\": %d, \"p\": %d, \"nbSeg\": %d, \"threads\": %d, \"repeat\": %d"
+              , benchmark, variant, storage_.c_str(), density_, n, p, nbSeg, threads, repeat);
+        for(size_t m = 0; m < metrics_.size(); m++)
+          printf(", \"%s\": %.9g", metrics_[m].first.c_str(), metrics_[m].second);
+        printf("}\n");
+      }
+      fflush(stdout);
+      metrics_.clear();
+    }
+
+  private:
+    /// if true the results are written in CSV
+    bool csv_;
+    /// storage of the design
+    std::string storage_;
+    /// proportion of non-zero values of the design
+    double density_;
+    /// metrics of the current result
+    std::vector<std::pair<std::string, double> > metrics_;
+};
+
+}//end namespace HD
+
+#endif /* BENCHTOOLS_H_ */
@@ -0,0 +1,176 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+/** @file checkAllocations.cpp
+ *  @brief Check that the steps of the lars algorithm do not allocate memory once
+ *  the buffers are reserved. operator new is replaced by a counting version; the
+ *  path is reserved with the number of coefficients of a first run, then the
+ *  allocations of the steps following the warm-up steps are counted for the QR,
+ *  Cholesky, Gram matrix and cache modes on simulated copy number data, and for the
+ *  QR mode on a view on the individuals of a fold (RowSubsetDesign) of the data
+ *  mapped from a file, whose columns are not cheap.
+ *  The cache has a few columns only, so that all of them are filled (allocated)
+ *  during the warm-up steps.
+ *
+ *  usage: checkAllocations [--n 200] [--p 1000] [--nbSeg 10] [--repeats 3] [--seed 1] [--file bench.bin]
+ *  The exit status is 1 if a step allocates memory after the warm-up.
+ **/
+
+#include <new>
+#include "../larsRmain.h"
+#include "benchTools.h"
+
+using namespace STK;
+using namespace std;
+using namespace HD;
+
+/// number of calls to operator new
+static long nbAlloc = 0;
+
+void* operator new(size_t size)
+{
+  nbAlloc++;
+  void* p = malloc(size ? size : 1);
+  if(!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept { free(p);}
+void operator delete(void* p, size_t) noexcept { free(p);}
+
+/// threshold of the lars algorithm, as in HDlars
+static const Real eps = 1e-8;
+/// number of steps before the allocations are counted
+static const int nbWarmUpSteps = 20;
+/// number of columns of the cache of X'X
+static const int nbCacheColumns = 4;
+/// number of folds of the view on the individuals, the individuals of the first fold are left out
+static const int nbFolds = 5;
+
+/* create a lars object
+ * @param p_design design of the QR mode on a view, NULL for X
+ * @param mode 0: QR, 1: Cholesky, 2: Gram matrix, 3: cache of the X'X columns, 4: QR on p_design
+ */
+static Lars* createLars(CArrayXX const& X, IDesign const* p_design, CVectorX const& y, int mode)
+{
+  int p = X.sizeCols(), maxSteps = 3*min(y.size(), p);
+  if(mode == 4) { return new Lars(*p_design, y, maxSteps, true, eps);}
+  Real cacheSize = (mode == 3) ? nbCacheColumns * p * sizeof(Real) / (1024. * 1024.) : 0.;
+  Lars* lars = new Lars(X, y, maxSteps, true, eps, mode == 2, cacheSize);
+  lars->setCholesky(mode == 1);
+  return lars;
+}
+
+/* run the lars algorithm step by step and count the allocations after the warm-up steps
+ * @return the number of allocations
+ */
+static long countAllocations(CArrayXX const& X, IDesign const* p_design, CVectorX const& y, int mode, int& nbSteps)
+{
+  //first run to know the size of the path
+  Lars* lars = createLars(X, p_design, y, mode);
+  lars->run();
+  int nbCoefficients = lars->path().nbCoefficients();
+  delete lars;
+
+  lars = createLars(X, p_design, y, mode);
+  lars->reservePath(nbCoefficients);
+  long before = 0;
+  nbSteps = 0;
+  if(lars->start())
+  {
+    while(true)
+    {
+      if(nbSteps == nbWarmUpSteps) { before = nbAlloc;}
+      if(!lars->beginStep()) break;
+      lars->endStep();
+      nbSteps++;
+    }
+  }
+  long nbAllocSteps = (nbSteps > nbWarmUpSteps) ? nbAlloc - before : 0;
+  delete lars;
+  return nbAllocSteps;
+}
+
+int main(int argc, char** argv)
+{
+  BenchOptions options;
+  options.p.assign(1, 1000);
+  if(!options.parse(argc, argv))
+  {
+    fprintf(stderr, "usage: checkAllocations [--n 200] [--p 1000] [--nbSeg 10] [--repeats 3] [--seed 1] [--file bench.bin]\n");
+    return 1;
+  }
+  static char const* modes[] = {"qr", "cholesky", "gram", "cache", "subset"};
+  SimulParameters param;
+  CArrayXX X;
+  CVectorX y;
+  vector<int> causalSNP;
+  bool ok = true;
+  for(size_t in = 0; in < options.n.size(); in++)
+  for(size_t ip = 0; ip < options.p.size(); ip++)
+  for(size_t is = 0; is < options.nbSeg.size(); is++)
+  for(int r = 0; r < options.nbRepeats; r++)
+  {
+    int n = options.n[in], p = options.p[ip], nbSeg = options.nbSeg[is];
+    simulCN(n, p, nbSeg, param, options.seed + r, X, y, causalSNP);
+    //X mapped from a file and the view on the individuals out of the first fold
+    FILE* file = fopen(options.fileName.c_str(), "wb");
+    bool written = file != 0;
+    for(int j = X.beginCols(); written && j < X.endCols(); j++)
+      written = fwrite(&X(X.beginRows(),j), sizeof(Real), n, file) == (size_t) n;
+    if(file) { fclose(file);}
+    if(!written)
+    {
+      fprintf(stderr, "cannot write the file %s\n", options.fileName.c_str());
+      return 1;
+    }
+    MappedDesign mapped(options.fileName, n);
+    vector<int> rows;
+    for(int i = 1; i <= n; i++)
+      if(i % nbFolds != 1) { rows.push_back(i);}
+    RowSubsetDesign view(mapped, rows);
+    CVectorX yView(Range(1,rows.size()));
+    for(int i = 0; i < (int) rows.size(); i++)
+      yView[i+1] = y[y.begin() + rows[i] - 1];
+
+    for(int mode = 0; mode < 5; mode++)
+    {
+      int nbSteps;
+      long nbAllocSteps = (mode == 4) ? countAllocations(X, &view, yView, mode, nbSteps)
+                                      : countAllocations(X, 0, y, mode, nbSteps);
+      printf("n=%d p=%d nbSeg=%d seed=%lu %-8s steps=%d allocations after %d steps: %ld %s\n"
+            , n, p, nbSeg, options.seed + r, modes[mode], nbSteps, nbWarmUpSteps, nbAllocSteps
+            , (nbAllocSteps == 0) ? "OK" : "FAILED");
+      if(nbAllocSteps != 0) { ok = false;}
+    }
+    remove(options.fileName.c_str());
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+/** @file checkPath.cpp
+ *  @brief Check the incremental solve of the equiangular system of the lars
+ *  algorithm (Lars::computeGi1) against the solve with one triangular system
+ *  per active variable (Lars::computeGi1Reference, see setReferenceSolve). The
+ *  two paths are computed on simulated copy number data, with the QR and the
+ *  Cholesky factors, and must have the same steps, the same active variables
+ *  and the same coefficients and lambda up to 1e-10 (relative to max(1,|x|)).
+ *  When the number of active variables comes close to n, Xi'Xi is ill-conditioned
+ *  and the two solves can differ by more than 1e-10 at the end of the path (1.7e-10
+ *  for n=200, p=300): the default grid keeps n=100.
+ *
+ *  usage: checkPath [--n 100] [--p 300,1000] [--nbSeg 10] [--repeats 5] [--seed 1]
+ *  The exit status is 1 if the paths differ.
+ **/
+
+#include "../larsRmain.h"
+#include "benchTools.h"
+
+using namespace STK;
+using namespace std;
+using namespace HD;
+
+/// threshold of the lars algorithm, as in HDlars
+static const Real eps = 1e-8;
+/// tolerance on the coefficients and the lambda
+static const Real tolerance = 1e-10;
+
+/* @return the relative difference of x and ref*/
+static Real relativeDiff(Real x, Real ref)
+{ return std::abs(x - ref) / std::max(Real(1.), std::abs(ref));}
+
+/* compare two paths
+ * @return the maximal difference of the coefficients and the lambda, -1 if the steps or the active sets differ
+ */
+static Real comparePaths(Path const& path, Path const& reference)
+{
+  if(path.size() != reference.size()) return -1.;
+  Real maxDiff = 0.;
+  for(int i = 0; i < path.size(); i++)
+  {
+    if(path.size(i) != reference.size(i)) return -1.;
+    for(int j = 1; j <= path.size(i); j++)
+    {
+      if(path.varIdx(i,j) != reference.varIdx(i,j)) return -1.;
+      maxDiff = std::max(maxDiff, relativeDiff(path.varCoeff(i,j), reference.varCoeff(i,j)));
+    }
+  }
+  for(int i = 0; i < (int) path.lambda().size(); i++)
+    maxDiff = std::max(maxDiff, relativeDiff(path.lambda(i), reference.lambda(i)));
+  return maxDiff;
+}
+
+/* run the lars algorithm
+ * @param useCholesky if true, use the Cholesky factor instead of the QR decomposition
+ * @param useReferenceSolve if true, use the reference solve of the equiangular system
+ */
+static void runLars(Lars& lars, bool useCholesky, bool useReferenceSolve)
+{
+  lars.setCholesky(useCholesky);
+  lars.setReferenceSolve(useReferenceSolve);
+  lars.run();
+}
+
+int main(int argc, char** argv)
+{
+  BenchOptions options;
+  options.n.assign(1, 100);
+  options.p.assign(1, 300); options.p.push_back(1000);
+  options.nbRepeats = 5;
+  if(!options.parse(argc, argv))
+  {
+    fprintf(stderr, "usage: checkPath [--n 100] [--p 300,1000] [--nbSeg 10] [--repeats 5] [--seed 1]\n");
+    return 1;
+  }
+  SimulParameters param;
+  CArrayXX X;
+  CVectorX y;
+  vector<int> causalSNP;
+  bool ok = true;
+  for(size_t in = 0; in < options.n.size(); in++)
+  for(size_t ip = 0; ip < options.p.size(); ip++)
+  for(size_t is = 0; is < options.nbSeg.size(); is++)
+  for(int r = 0; r < options.nbRepeats; r++)
+  {
+    int n = options.n[in], p = options.p[ip], nbSeg = options.nbSeg[is];
+    int maxSteps = 3*min(n, p);
+    simulCN(n, p, nbSeg, param, options.seed + r, X, y, causalSNP);
+    for(int chol = 0; chol < 2; chol++)
+    {
+      Lars lars(X, y, maxSteps, true, eps), reference(X, y, maxSteps, true, eps);
+      runLars(lars, chol == 1, false);
+      runLars(reference, chol == 1, true);
+      Real maxDiff = comparePaths(lars.path(), reference.path());
+      bool isSame = (maxDiff >= 0.) && (maxDiff <= tolerance);
+      printf("n=%d p=%d nbSeg=%d seed=%lu %-8s steps=%d max difference: %g %s\n"
+            , n, p, nbSeg, options.seed + r, chol ? "cholesky" : "qr", lars.step(), maxDiff
+            , isSame ? "OK" : "FAILED");
+      if(!isSame) { ok = false;}
+    }
+  }
+  return ok ? 0 : 1;
+}
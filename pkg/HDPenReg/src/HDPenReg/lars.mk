@@ -13,10 +13,18 @@ LIB = ./lib/libEM.a
 #
 SRCS =./lars/Lars.cpp \
 			./lars/Path.cpp \
+			./lars/GramCache.cpp \
+			./lars/Cholesky.cpp \
+			./lars/QrFactor.cpp \
+			./lars/LarsWorkspace.cpp \
+			./lars/Timings.cpp \
+			./lars/Design.cpp \
+			./lars/MappedDesign.cpp \
 			./lars/PathState.cpp \
 			./lars/functions.cpp \
  			./lars/Fusion.cpp \
 			./lars/Cvlars.cpp \
+			./lars/MultiLars.cpp \
 			./larsRmain.cpp
 
 
@@ -0,0 +1,130 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file Cholesky.cpp
+ *  @brief Code of methods associates to @c Cholesky.
+ **/
+
+#include <cmath>
+#include <algorithm>
+#include "../larsRmain.h"
+
+using namespace STK;
+using namespace std;
+
+namespace HD
+{
+/* default constructor: empty factor*/
+Cholesky::Cholesky() : data_(), size_(0)
+{}
+
+/* reserve the memory for kMax columns*/
+void Cholesky::reserve(int kMax)
+{ data_.reserve(offset(kMax));}
+
+/* remove all the columns*/
+void Cholesky::clear()
+{
+  data_.clear();
+  size_ = 0;
+}
+
+/*
+ * add a column to G
+ * @param g cross products of the new variable with the active variables
+ * @param d squared norm of the new variable
+ * @param eps threshold of colinearity
+ * @return false if the new variable is colinear with the active ones
+ */
+bool Cholesky::pushBackCol(CVectorX const& g, Real d, Real eps)
+{
+  int k = size_;
+  //no allocation if the memory has been reserved
+  data_.resize(offset(k+1));
+  Real* col = &data_[offset(k)];
+  //resolve R'*r = g
+  Real norm2 = 0.;
+  for(int i = 0, ig = g.begin(); i < k; i++, ig++)
+  {
+    Real const* colI = &data_[offset(i)];
+    Real sum = g[ig];
+    for(int l = 0; l < i; l++)
+      sum -= colI[l] * col[l];
+    col[i] = sum/colI[i];
+    norm2 += col[i] * col[i];
+  }
+  //squared norm of the part of the variable orthogonal to the active ones. Its rounding errors
+  //are of the order of k*epsilon*d: below, the variable is colinear with the active ones
+  Real diag2 = d - norm2;
+  if( (diag2 < eps*eps) || (diag2 <= 10. * (k+1) * Arithmetic<Real>::epsilon() * d) )
+  {
+    data_.resize(offset(k));
+    return false;
+  }
+  col[k] = sqrt(diag2);
+  size_++;
+  return true;
+}
+
+/*
+ * remove the column j of G
+ * @param j index of the column to remove
+ */
+void Cholesky::eraseCol(int j)
+{
+  //without the column j, the column c (0-based) of R after j has c+1 rows (the old column c+1):
+  //the element (c+1,c) is removed with a rotation of the rows c and c+1 of the following columns.
+  //The rotations are done in place, before moving the columns.
+  for(int c = j-1; c < size_-1; c++)
+  {
+    Real* col = &data_[offset(c+1)];
+    Real a = col[c], b = col[c+1];
+    Real r = sqrt(a*a + b*b);
+    if(r > 0.)
+    {
+      Real cosG = a/r, sinG = b/r;
+      col[c] = r;
+      for(int l = c+2; l < size_; l++)
+      {
+        Real* colL = &data_[offset(l)];
+        Real x = colL[c], y = colL[c+1];
+        colL[c]   =  cosG * x + sinG * y;
+        colL[c+1] = -sinG * x + cosG * y;
+      }
+    }
+  }
+  //the column c+1 (c+1 first rows) is moved at the place of the column c, in increasing order
+  for(int c = j-1; c < size_-1; c++)
+    std::copy(data_.begin() + offset(c+1), data_.begin() + offset(c+1) + (c+1), data_.begin() + offset(c));
+  size_--;
+  data_.resize(offset(size_));
+}
+
+}//end namespace HD
@@ -0,0 +1,106 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file Cholesky.h
+ *  @brief In this file, we define the class @c Cholesky.
+ **/
+
+
+#ifndef CHOLESKY_H_
+#define CHOLESKY_H_
+
+namespace HD
+{
+/**
+ * Cholesky factor R (upper triangular, R'R = G) of the Gram matrix G = Xi'Xi of the
+ * active variables of the lars algorithm.
+ *
+ * A variable is added with its cross products with the active variables (a new
+ * column of G) and removed with Givens rotations, as the R of a QR decomposition
+ * but without the Q factor: the memory is O(k^2) instead of O(nk). The upper
+ * triangle is packed in a single array: once reserve has been called, adding or
+ * removing a column does not allocate memory. Rows and columns are indexed from 1.
+ */
+  class Cholesky
+  {
+    public:
+      /** default constructor: empty factor*/
+      Cholesky();
+
+      /** @return the number of columns of the factor*/
+      inline int size() const {return size_;}
+      /**
+       * @param i index of the row
+       * @param j index of the column, i <= j
+       * @return the element (i,j) of R
+       */
+      inline STK::Real operator()(int i, int j) const {return data_[offset(j-1) + i-1];}
+
+      /**
+       * reserve the memory for kMax columns, kMax(kMax+1)/2 reals
+       * @param kMax maximal number of columns
+       */
+      void reserve(int kMax);
+      /** remove all the columns*/
+      void clear();
+      /**
+       * add a column to G. The diagonal element of R is the norm of the part of the new
+       * variable orthogonal to the active ones, as the diagonal element of the R of a QR
+       * decomposition: the column is not added if it is lower than eps. It is computed as d - r'r,
+       * so the column is not added either if it is at the level of the rounding errors of d.
+       * @param g cross products of the new variable with the active variables, size size()
+       * @param d squared norm of the new variable
+       * @param eps threshold of colinearity
+       * @return false if the new variable is colinear with the active ones
+       */
+      bool pushBackCol(STK::CVectorX const& g, STK::Real d, STK::Real eps);
+      /**
+       * remove the column j of G. The columns of R after j are made upper triangular
+       * again with Givens rotations on the rows.
+       * @param j index of the column to remove
+       */
+      void eraseCol(int j);
+
+    private:
+      /**
+       * @param c index of a column, from 0
+       * @return position of the first element of the column c in data_
+       */
+      inline static size_t offset(int c) {return (size_t) c * (c+1) / 2;}
+
+      /// columns of R one after the other, the column j contains the rows 1 to j
+      std::vector<STK::Real> data_;
+      /// number of columns of R
+      int size_;
+  };
+
+}//end namespace
+
+#endif /* CHOLESKY_H_ */
@@ -32,6 +32,7 @@
  *  @brief In this file, implementation of the methods of @c Cvlars .
  **/
 
+#include <algorithm>
 #include "../larsRmain.h"
 
 using namespace STK;
@@ -49,7 +50,8 @@ namespace HD
  * @param eps epsilon (for 0)
  */
 Cvlars::Cvlars(STK::CArrayXX const& X, STK::CVectorX const& y, int nbFolds, int maxSteps, bool intercept, STK::Real eps)
-              : p_X_(&X)
+              : p_ownDesign_(new ArrayDesign(X))
+              , p_X_(p_ownDesign_)
               , p_y_(&y)
               , partition_(X.sizeRows())
               , sizePartition_(nbFolds,0)
@@ -58,12 +60,19 @@ Cvlars::Cvlars(STK::CArrayXX const& X, STK::CVectorX const& y, int nbFolds, int
               , residuals_(Range(1,101), Range(1,nbFolds))
               , cv_(Range(1,101), 0.)
               , cvError_(Range(1,101), 0.)
+              , cvRepeats_(Range(1,101), Range(1,1), 0.)
               , nbFolds_(nbFolds)
+              , nbRepeats_(1)
+              , seed_(time(NULL))
               , n_(X.sizeRows())
               , p_(X.sizeCols())
               , maxSteps_(maxSteps)
               , eps_(eps)
               , intercept_(intercept)
+              , useGram_(false)
+              , gram_()
+              , muX_()
+              , timings_()
 {
   //no index given, we created a sequence of index between 0 and 1
   for(int i = 0; i<101; i++)
@@ -85,7 +94,8 @@ Cvlars::Cvlars( STK::CArrayXX const& X
               , STK::CVectorX const& y, int k
               , std::vector<double> const& index
               , bool lambdaMode,int maxSteps, bool intercept, STK::Real eps)
-              : p_X_(&X)
+              : p_ownDesign_(new ArrayDesign(X))
+              , p_X_(p_ownDesign_)
               , p_y_(&y)
               , partition_(X.sizeRows())
               , sizePartition_(k,0)
@@ -94,41 +104,152 @@ Cvlars::Cvlars( STK::CArrayXX const& X
               , residuals_(Range(1,index.size()), Range(1,k))
               , cv_(Range(1,index.size()) ,0.)
               , cvError_(Range(1,index.size()), 0.)
+              , cvRepeats_(Range(1,index.size()), Range(1,1), 0.)
               , nbFolds_(k)
+              , nbRepeats_(1)
+              , seed_(time(NULL))
               , n_(X.sizeRows())
               , p_(X.sizeCols())
               , maxSteps_(maxSteps)
               , eps_(eps)
               , intercept_(intercept)
+              , useGram_(false)
+              , gram_()
+              , muX_()
+              , timings_()
 {
   //create the partition
   partition();
 }
 
 /*
- * create a random partition in k folds
+ * Constructor with no index ( it will be a sequence from 0 to 1 by 0.01)
+ * @param X design, a row=a individual
+ * @param y response
+ * @param nbFolds number of folds
+ * @param maxSteps number of maximum step to do
+ * @param eps epsilon (for 0)
+ */
+Cvlars::Cvlars(IDesign const& X, STK::CVectorX const& y, int nbFolds, int maxSteps, bool intercept, STK::Real eps)
+              : p_ownDesign_(0)
+              , p_X_(&X)
+              , p_y_(&y)
+              , partition_(X.sizeRows())
+              , sizePartition_(nbFolds,0)
+              , index_(101)
+              , lambdaMode_(false)
+              , residuals_(Range(1,101), Range(1,nbFolds))
+              , cv_(Range(1,101), 0.)
+              , cvError_(Range(1,101), 0.)
+              , cvRepeats_(Range(1,101), Range(1,1), 0.)
+              , nbFolds_(nbFolds)
+              , nbRepeats_(1)
+              , seed_(time(NULL))
+              , n_(X.sizeRows())
+              , p_(X.sizeCols())
+              , maxSteps_(maxSteps)
+              , eps_(eps)
+              , intercept_(intercept)
+              , useGram_(false)
+              , gram_()
+              , muX_()
+              , timings_()
+{
+  //no index given, we created a sequence of index between 0 and 1
+  for(int i = 0; i<101; i++)
+    index_[i] = (double) i/100;
+  //create the partition
+  partition();
+}
+
+/*
+ * Constructor
+ * @param X design, a row=a individual
+ * @param y response
+ * @param k number of folds
+ * @param index vector with real between 0 and 1 (ratio (norm coefficient)/max(norm coefficient) for which we compute the prediction error)
+ * @param maxSteps number of maximum step to do
+ * @param eps epsilon (for 0)
+ */
+Cvlars::Cvlars( IDesign const& X
+              , STK::CVectorX const& y, int k
+              , std::vector<double> const& index
+              , bool lambdaMode,int maxSteps, bool intercept, STK::Real eps)
+              : p_ownDesign_(0)
+              , p_X_(&X)
+              , p_y_(&y)
+              , partition_(X.sizeRows())
+              , sizePartition_(k,0)
+              , index_(index)
+              , lambdaMode_(lambdaMode)
+              , residuals_(Range(1,index.size()), Range(1,k))
+              , cv_(Range(1,index.size()) ,0.)
+              , cvError_(Range(1,index.size()), 0.)
+              , cvRepeats_(Range(1,index.size()), Range(1,1), 0.)
+              , nbFolds_(k)
+              , nbRepeats_(1)
+              , seed_(time(NULL))
+              , n_(X.sizeRows())
+              , p_(X.sizeCols())
+              , maxSteps_(maxSteps)
+              , eps_(eps)
+              , intercept_(intercept)
+              , useGram_(false)
+              , gram_()
+              , muX_()
+              , timings_()
+{
+  //create the partition
+  partition();
+}
+
+/* destructor*/
+Cvlars::~Cvlars()
+{ if(p_ownDesign_) delete p_ownDesign_;}
+
+/*
+ * create a random partition in k folds for each repeat
  */
 void Cvlars::partition()
 {
-  //fill the container with the index of folds
-  for(int i = 0 ; i< n_ ;i++)
+  //the size of the folds is the same for all the repeats
+  sizePartition_.assign(nbFolds_, 0);
+  for(int i = 0 ; i< n_ ;i++) { sizePartition_[i%nbFolds_]++;}
+  //each repeat has its own stream of the generator: the partitions do not depend on the order of the draws
+  partition_.resize(n_ * nbRepeats_);
+  std::vector<int> part;
+  for(int r = 0; r < nbRepeats_; r++)
   {
-    partition_[i] = i%nbFolds_;
-    sizePartition_[i%nbFolds_]++;
+    randomPartition(n_, nbFolds_, seed_, r, part);
+    std::copy(part.begin(), part.end(), partition_.begin() + r * n_);
   }
-  //make a random rearrangement
-  srand(time(NULL));
-  random_shuffle(partition_.begin(),partition_.end());
 }
 
 void Cvlars::setPartition(std::vector<int> const& partition)
 {
+  nbRepeats_ = 1;
+  residuals_.resize(Range(1,index_.size()), Range(1,nbFolds_));
+  cvRepeats_.resize(Range(1,index_.size()), Range(1,1));
   partition_ = partition;
   sizePartition_.resize(nbFolds_);
   for(int i = 0; i < nbFolds_; i++) { sizePartition_[i] = 0;}
   for(int i = 0; i < n_; i++) { sizePartition_[partition_[i]]++;}
 }
 
+/*
+ * repeat the cross validation with nbRepeats random partitions
+ * @param nbRepeats number of repeats
+ * @param seed seed of the generator
+ */
+void Cvlars::setRepeats(int nbRepeats, unsigned long seed)
+{
+  nbRepeats_ = nbRepeats;
+  seed_ = seed;
+  residuals_.resize(Range(1,index_.size()), Range(1,nbFolds_*nbRepeats_));
+  cvRepeats_.resize(Range(1,index_.size()), Range(1,nbRepeats_));
+  partition();
+}
+
   /*
    * run the cross validation
    */
@@ -137,184 +258,187 @@ void Cvlars::setPartition(std::vector<int> const& partition)
 #ifdef CVLARS_DEBUG
   stk_cerr << _T("Entering Cvlars::run")<<endl;
 #endif
-    //search the first and last fold with the same size
-    std::vector<int> startIndex(1,0), endIndex(1, nbFolds_-1);
-    int k = 0;
-    for(int i = 1; i < nbFolds_; i++)
+    timings_.reset();
+    if(useGram_) { computeGram();}
+    for(int r = 0; r < nbRepeats_; r++)
     {
-      if(sizePartition_[i]!= sizePartition_[startIndex[k]])
-      {
-        startIndex.push_back(i);
-        endIndex[k] = i-1;
-        endIndex.push_back(nbFolds_-1);
-        k++;
-      }
+      for(int i = 0; i < nbFolds_; i++) { runFold(r,i);}
     }
-    //run for each size of fold
-#ifdef CVLARS_DEBUG
-  stk_cerr << _T("Cvlars::run, launch subrun")<<endl;
-#endif
-    for(int i = 0; i < (int) startIndex.size(); i++)
-    {  subrun(startIndex[i],endIndex[i]);}
-#ifdef CVLARS_DEBUG
-  stk_cerr << _T("Cvlars::run, subrun done")<<endl;
-#endif
-    // compute mean prediction error for each index
-//    STK::CVectorX one(nbFolds_,1);
-//    cv_ = (residuals_ * one) / nbFolds_;
-    // compute mean standard deviation of cv_ for each index
-//    for(int i = 1; i <= (int) index_.size(); i++)
-//      residuals_.row(i) -= cv_[i];
-//
-//    residuals_ = residuals_.square();
-//    cvError_ = (residuals_ * one)/(nbFolds_-1)/nbFolds_;
-//    cvError_ = cvError_.sqrt();
-
-    cv_      = Stat::meanByRow(residuals_);
-    cvError_ = Stat::varianceByRow(residuals_, true).sqrt();
+    computeCv();
 #ifdef CVLARS_DEBUG
 stk_cerr << _T("Cvlars::run done")<<endl;
 #endif
   }
 
 /*
- * run cross validation for folds from idxStartFold to idxEndFold
- * @param idxStartFold index of the first fold
- * @param idxEndFold index of the last fold
+ * compute cv_, cvError_ and cvRepeats_ from the residuals of the folds
  */
-void Cvlars::subrun(int idxStartFold,int idxEndFold)
+void Cvlars::computeCv()
 {
-#ifdef CVLARS_DEBUG
-  stk_cerr << _T("Entering Cvlars::subrun")<<endl;
-  stk_cerr << _T("idxStartFold=") << idxStartFold <<endl;
-  stk_cerr << _T("idxEndFold=")   << idxEndFold <<endl;
-  stk_cerr << _T("sizePartition_[idxStartFold]=")   << sizePartition_[idxStartFold] <<endl;
-#endif
+  cv_      = Stat::meanByRow(residuals_);
+  cvError_ = Stat::varianceByRow(residuals_, true).sqrt();
+  for(int r = 0; r < nbRepeats_; r++)
+  {
+    for(int s = residuals_.beginRows(); s < residuals_.endRows(); s++)
+    {
+      Real sum = 0.;
+      for(int i = 1; i <= nbFolds_; i++) { sum += residuals_(s, r*nbFolds_+i);}
+      cvRepeats_(s, r+1) = sum/nbFolds_;
+    }
+  }
+}
 
+/*
+ * run lars on the control individuals of a fold and compute the prediction error of the test individuals
+ * @param idxRepeat index of the repeat
+ * @param idxFold index of the fold
+ */
+void Cvlars::runFold(int idxRepeat, int idxFold)
+{
+  std::vector<int>::const_iterator part = partition_.begin() + idxRepeat * n_;
   //create test and control container
-  Range rangeControl(1, n_ - sizePartition_[idxStartFold]);
-  Range rangeTest(1, sizePartition_[idxStartFold]);
-  Range rangeCols(1, p_);
-  STK::CArrayXX XControl(rangeControl, rangeCols);
+  Range rangeControl(1, n_ - sizePartition_[idxFold]);
+  Range rangeTest(1, sizePartition_[idxFold]);
   STK::CVectorX yControl(rangeControl);
-
-  STK::CArrayXX XTest(rangeTest, rangeCols);
   STK::CVectorX yTest(rangeTest);
+  STK::CArrayXX yPred(rangeTest, Range(1,index_.size()));
+  std::vector<int> rowsControl, rowsTest;
+  rowsControl.reserve(rangeControl.size());
+  rowsTest.reserve(rangeTest.size());
 
-  STK::CVectorX yPred(rangeTest);
-
-  for(int i = idxStartFold ; i <= idxEndFold ; i++)
+  //fill the container
+  int index1 = yControl.begin();
+  int index2 = yTest.begin();
+  for(int j = p_y_->begin(); j < p_y_->end(); j++)
   {
-    //fill the container
-    int index1 = yControl.begin();
-    int index2 = yTest.begin();
-    for(int j = p_y_->begin(); j < p_y_->end(); j++)
+    if(part[j-p_y_->begin()] != idxFold)
     {
-      if(partition_[j-1] != i)
-      {
-        yControl[index1]    =p_y_->elt(j);
-        XControl.row(index1)=p_X_->row(j);
-        index1++;
-      }
-      else
-      {
-        yTest[index2]    = p_y_->elt(j);
-        XTest.row(index2)= p_X_->row(j);
-        index2++;
-      }
+      yControl[index1] = p_y_->elt(j);
+      rowsControl.push_back(j);
+      index1++;
     }
-    //run lars on control data set
-    HD::Lars lars(XControl,yControl,maxSteps_,intercept_,eps_);
-    lars.run();
-    for(int s = residuals_.beginRows() ; s < residuals_.endRows(); s++)
+    else
     {
-      //we compute the prediction of the y associated to XTest
-      lars.predict( XTest, index_[s-1], lambdaMode_, yPred);
-      //compute the residuals
-      residuals_(s,i+1) = (yPred-yTest).square().sum()/sizePartition_[i];
+      yTest[index2] = p_y_->elt(j);
+      rowsTest.push_back(j);
+      index2++;
     }
   }
+  //the control and test designs are views on the whole design, the data are not copied
+  RowSubsetDesign XControl(*p_X_, rowsControl);
+  RowSubsetDesign XTest(*p_X_, rowsTest);
+
+  //run lars on control data set
+  HD::Lars* p_lars;
+  Timings gramTimings;
+  if(useGram_)
+  {
+    STK::CArrayXX gramControl;
+    {
+      Timings::Timer timer(gramTimings, Timings::initialization);
+      computeFoldGram(XTest, rangeControl.size(), gramControl);
+    }
+    p_lars = new HD::Lars(XControl,yControl,gramControl,maxSteps_,intercept_,eps_);
+  }
+  else
+  { p_lars = new HD::Lars(XControl,yControl,maxSteps_,intercept_,eps_);}
+  HD::Lars& lars = *p_lars;
+  //with the Gram matrix of the fold, the active set is factorized from gramControl only: the steps
+  //do not read the rows of X
+  if(useGram_) { lars.setCholesky(true);}
+  //in lambda mode, the path below the smallest requested lambda is never evaluated
+  if(lambdaMode_) { lars.setMinLambda(*min_element(index_.begin(), index_.end()));}
+  lars.run();
+  //we compute the prediction of the y associated to XTest for all the index at once
+  lars.predict( XTest, index_, lambdaMode_, yPred);
+  //the folds can run in parallel
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+  {
+    timings_ += gramTimings;
+    timings_ += lars.timings();
+  }
+  delete p_lars;
+  for(int s = residuals_.beginRows() ; s < residuals_.endRows(); s++)
+  {
+    //compute the residuals
+    Real rss = 0.;
+    for(int i = yTest.begin(); i < yTest.end(); i++)
+    { rss += (yPred(i,s)-yTest[i])*(yPred(i,s)-yTest[i]);}
+    residuals_(s,idxRepeat*nbFolds_+idxFold+1) = rss/sizePartition_[idxFold];
+  }
+}
+
+/*
+ * compute the means of the covariates and X'X on the whole data set
+ */
+void Cvlars::computeGram()
+{
+  Timings::Timer timer(timings_, Timings::initialization);
+  muX_.resize(Range(1,p_));
+  for(int j = 1; j <= p_; j++) { muX_[j] = intercept_ ? p_X_->colMean(j) : 0.;}
+  gram_.resize(Range(1,p_),Range(1,p_));
+  CVectorX xc(Range(1,n_)), gramCol(Range(1,p_));
+  for(int j = 1; j <= p_; j++)
+  {
+    xc = -muX_[j];
+    p_X_->addCol(j,1.,xc);
+    p_X_->transposeProduct(xc,gramCol);
+    Real sumXc = xc.sum();
+    for(int i = 1; i <= p_; i++)
+      gram_(i,j) = gramCol[i] - muX_[i] * sumXc;
+  }
+}
+
+/*
+ * compute the Gram matrix of the control individuals of a fold
+ * @param XTest design of the test individuals
+ * @param nControl number of control individuals
+ * @param gramControl Gram matrix of the control individuals
+ */
+void Cvlars::computeFoldGram(IDesign const& XTest, int nControl, CArrayXX& gramControl) const
+{
+  int nTest = XTest.sizeRows();
+  gramControl = gram_;
+  //sums of the test individuals, centered with the means of the whole data set
+  CVectorX sumTest(Range(1,p_));
+  CVectorX xc(Range(1,nTest)), crossCol(Range(1,p_));
+  for(int j = 1; j <= p_; j++)
+  {
+    xc = -muX_[j];
+    XTest.addCol(j,1.,xc);
+    sumTest[j] = xc.sum();
+    XTest.transposeProduct(xc,crossCol);
+    for(int i = 1; i <= p_; i++)
+      gramControl(i,j) -= crossCol[i] - muX_[i] * sumTest[j];
+  }
+  //the control individuals are centered with their own means: mean of the control rows of the
+  //centered X is -sumTest/nControl
+  if(intercept_)
+  {
+    for(int j = 1; j <= p_; j++)
+      for(int i = 1; i <= p_; i++)
+        gramControl(i,j) -= sumTest[i] * sumTest[j] / nControl;
+  }
 }
 
 #ifdef _OPENMP
 void Cvlars::run2()
  {
-   //search the first and last fold with the same size
-   std::vector<int> startIndex(1,0),endIndex(1,nbFolds_-1);
-   int k = 0;
-   for(int i = 1; i < nbFolds_; i++)
-   {
-     if(sizePartition_[i]!= sizePartition_[startIndex[k]])
-     {
-       startIndex.push_back(i);
-       endIndex[k] = i-1;
-       endIndex.push_back(nbFolds_-1);
-       k++;
-     }
-   }
-
-   //run for each size of fold
-   //create test and control container
+   timings_.reset();
+   if(useGram_) { computeGram();}
+   //the folds of all the repeats are run as one set of tasks, sharing the design
+   int nbTasks = nbRepeats_ * nbFolds_;
    #pragma omp parallel
    {
      #pragma omp for schedule(dynamic,1)
-     for(int i = 0; i < nbFolds_ ; i++)
+     for(int t = 0; t < nbTasks ; t++)
      {
-       Range rangeControl(1, n_ - sizePartition_[i]);
-       Range rangeTest(1, sizePartition_[i]);
-       STK::CArrayXX XControl( rangeControl, Range(1,p_));
-       STK::CVectorX yControl( rangeControl);
-
-       STK::CArrayXX XTest(rangeTest, Range(1,p_));
-       STK::CVectorX yTest(rangeTest);
-
-       STK::CVectorX yPred(rangeTest);
-
-       //fill the container
-       int index1 = 1;
-       int index2 = 1;
-       for(int j = p_y_->begin(); j < p_y_->end(); j++)
-       {
-         if(partition_[j-1] != i)
-         {
-           yControl[index1]    = p_y_->elt(j);
-           XControl.row(index1)= p_X_->row(j);
-           index1++;
-         }
-         else
-         {
-           yTest[index2]    = p_y_->elt(j);
-           XTest.row(index2)= p_X_->row(j);
-           index2++;
-         }
-       }
-
-       //run lars on control data set
-       HD::Lars lars(XControl,yControl,maxSteps_,intercept_,eps_);
-       lars.run();
-
-       for(int s = residuals_.beginRows() ; s < residuals_.endRows(); s++)
-       {
-         //we compute the prediction of the y associated to XTest
-         lars.predict(XTest,index_[s-1], lambdaMode_, yPred);
-         //compute the residuals
-         residuals_(s,i+1) = (yPred-yTest).square().sum()/sizePartition_[i];
-       }
+       runFold(t/nbFolds_, t%nbFolds_);
      }
    }//end parallel
-
-   // compute mean prediction error for each index
-//   STK::CVectorX one(nbFolds_,1);
-//   cv_ = (residuals_ * one) / nbFolds_;
-//
-//   // compute mean standard deviation of cv_ for each index
-//   for(int i = 1; i <= (int) index_.size(); i++)
-//     residuals_.row(i) -= cv_[i];
-//   residuals_ = residuals_.square();
-//   cvError_ = (residuals_ * one)/(nbFolds_-1)/nbFolds_;
-//   cvError_ = cvError_.sqrt();
-   cv_      = Stat::meanByRow(residuals_);
-   cvError_ = Stat::varianceByRow(residuals_, true).sqrt();
+   computeCv();
 }
 #endif
 
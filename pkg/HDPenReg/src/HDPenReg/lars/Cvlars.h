@@ -69,12 +69,39 @@ namespace HD
       Cvlars(STK::CArrayXX const& X, STK::CVectorX const& y, int nbFolds, std::vector<double> const& index, bool lambdaMode, int maxSteps, bool intercept = true, STK::Real eps = STK::Arithmetic<STK::Real>::epsilon());
 
       /**
-       * run a k-fold cross validation
+       * Constructor with no index ( it will be a sequence from 0 to 1 by 0.01)
+       * @param X design, a row=a individual. X must exist as long as the object
+       * @param y response
+       * @param nbFolds number of folds
+       * @param maxSteps number of maximum step to do
+       * @param intercept if true, there is an intercept in the model
+       * @param eps epsilon (for 0)
+       */
+      Cvlars(IDesign const& X, STK::CVectorX const& y, int nbFolds, int maxSteps, bool intercept = true, STK::Real eps = STK::Arithmetic<STK::Real>::epsilon());
+
+      /**
+       * Constructor
+       * @param X design, a row=a individual. X must exist as long as the object
+       * @param y response
+       * @param nbFolds number of folds
+       * @param index elements to test for cross validation (l1norm fraction or lambda)
+       * @param lambdaMode if true index contains lambda values, else it contains real between 0 and 1 (ratio (norm coefficient)/max(norm coefficient) for which we compute the prediction error)
+       * @param maxSteps number of maximum step to do
+       * @param intercept if true, there is an intercept in the model
+       * @param eps epsilon (for 0)
+       */
+      Cvlars(IDesign const& X, STK::CVectorX const& y, int nbFolds, std::vector<double> const& index, bool lambdaMode, int maxSteps, bool intercept = true, STK::Real eps = STK::Arithmetic<STK::Real>::epsilon());
+
+      /** destructor*/
+      ~Cvlars();
+
+      /**
+       * run a k-fold cross validation, repeated nbRepeats times (see setRepeats)
        */
       void run();
 #ifdef _OPENMP
       /**
-       * run a k-fold cross validation (parallelized version)
+       * run a k-fold cross validation (parallelized version). The nbRepeats*k folds are run as one set of tasks
        */
       void run2();
 #endif
@@ -83,29 +110,72 @@ namespace HD
       inline STK::CVectorX const& cv() const {return cv_;}
       /** @return return the standard deviation of prediction error for each index*/
       inline STK::CVectorX const& cvError() const {return cvError_;}
+      /** @return return the prediction error of each repeat (column) for each index (row)*/
+      inline STK::CArrayXX const& cvRepeats() const {return cvRepeats_;}
       /** @return return the index*/
       inline std::vector<double> const& index() const {return index_;}
-      /**@param partition of the */
+      /** @return cumulative timings and counters of the lars of all the folds*/
+      inline Timings const& timings() const {return timings_;}
+      /**
+       * set the partition in folds. The cross validation is not repeated.
+       * @param partition index of the fold (between 0 and k-1) of each individual
+       */
       void setPartition(std::vector<int> const& partition);
+      /**
+       * repeat the cross validation with nbRepeats random partitions. The partition of the repeat r is
+       * drawn with the stream r of a counter based generator, so the partitions depend only on seed.
+       * @param nbRepeats number of repeats
+       * @param seed seed of the generator
+       */
+      void setRepeats(int nbRepeats, unsigned long seed);
+      /**
+       * compute X'X once on the whole data set. The Gram matrix of the control individuals of a fold is
+       * then X'X minus the cross products of the test individuals, and lars runs in the space of the variables.
+       * Not used if the design has missing values: X'X would replace them by the means of all the individuals.
+       * @param useGram if true, the folds are run with a Gram matrix
+       */
+      inline void setGram(bool useGram) {useGram_ = useGram && !p_X_->hasMissingValues();}
 
     private:
       /**
-       * create a random partition in k folds
+       * create a random partition in k folds for each repeat
        */
       void partition();
       /**
-       * run cross validation for folds from idxStartFold to idxEndFold
-       * @param idxStartFold index of the first fold
-       * @param idxEndFold index of the last fold
+       * run lars on the control individuals of a fold and compute the prediction error of the test individuals
+       * @param idxRepeat index of the repeat
+       * @param idxFold index of the fold
+       */
+      void runFold(int idxRepeat, int idxFold);
+      /**
+       * compute cv_, cvError_ and cvRepeats_ from the residuals of the folds
+       */
+      void computeCv();
+      /**
+       * compute the means of the covariates and X'X (with X centered if there is an intercept) on the whole data set
+       */
+      void computeGram();
+      /**
+       * compute the Gram matrix of the control individuals of a fold by removing the test individuals from gram_:
+       * G_control = gram_ - T - s*s'/nControl, with T the cross products and s the sums of the test individuals
+       * centered with the means of the whole data set
+       * @param XTest design of the test individuals
+       * @param nControl number of control individuals
+       * @param gramControl Gram matrix of the control individuals (with X centered if there is an intercept)
        */
-      void subrun(int idxStartFold,int idxEndFold);
+      void computeFoldGram(IDesign const& XTest, int nControl, STK::CArrayXX& gramControl) const;
+      /** no copy: the object can own its design*/
+      Cvlars(Cvlars const&);
+      Cvlars& operator=(Cvlars const&);
 
     private:
-      ///pointer on the data
-      STK::CArrayXX const* p_X_;
+      ///design created by the object when it is constructed with a STK::CArrayXX, NULL otherwise
+      IDesign* p_ownDesign_;
+      ///pointer on the design
+      IDesign const* p_X_;
       ///pointer on the response
       STK::CVectorX const* p_y_;
-      ///repartition of the sample into k-folds
+      ///repartition of the sample into k-folds, the partition of the repeat r is in partition_[r*n_] ... partition_[(r+1)*n_-1]
       std::vector<int> partition_;
       ///size of each fold
       std::vector<int> sizePartition_;
@@ -114,14 +184,20 @@ namespace HD
       std::vector<double> index_;
       ///if true, index is fraction, else it's lambda
       bool lambdaMode_;
-      ///residuals
+      ///residuals, the column r*k+i+1 for the fold i of the repeat r
       STK::CArrayXX residuals_;
       ///criterion
       STK::CVectorX cv_;
       ///criterion error
       STK::CVectorX cvError_;
+      ///criterion of each repeat
+      STK::CArrayXX cvRepeats_;
       ///number of folds
       int nbFolds_;
+      ///number of repeats of the cross validation
+      int nbRepeats_;
+      ///seed of the generator of the partitions
+      unsigned long seed_;
       ///number of sample
       int n_;
       ///number of variables
@@ -132,6 +208,14 @@ namespace HD
       STK::Real eps_;
       /// if true, there is an intercept in the model
       bool intercept_;
+      /// if true, the Gram matrix of each fold is derived from gram_
+      bool useGram_;
+      /// X'X of the whole data set if useGram_ is true, empty otherwise
+      STK::CArrayXX gram_;
+      /// mean of each covariate on the whole data set if useGram_ is true
+      STK::CVectorX muX_;
+      /// timings and counters summed over the folds, the Gram matrices are counted in the initialization
+      Timings timings_;
   };
 }
 
@@ -0,0 +1,709 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file Design.cpp
+ *  @brief Code of methods associates to @c ArrayDesign, @c BufferDesign, @c FloatDesign,
+ *  @c SparseDesign, @c GenotypeDesign, @c FusionDesign, @c RowSubsetDesign and @c ActiveColumns.
+ **/
+
+#include "../larsRmain.h"
+
+using namespace STK;
+using namespace std;
+
+namespace HD
+{
+/*
+ * Constructor
+ * @param X matrix of data, a row=a individual
+ */
+ArrayDesign::ArrayDesign(CArrayXX const& X) : data_(), p_X_(&X) {}
+
+/*
+ * Constructor, the design owns its data
+ * @param n number of individuals
+ * @param p number of variables
+ */
+ArrayDesign::ArrayDesign(int n, int p) : data_(Range(1,n), Range(1,p), 0.), p_X_(&data_) {}
+
+Real ArrayDesign::dot(int j, CVectorX const& v) const
+{
+  Real sum = 0.;
+  for(int i = v.begin(), iX = p_X_->beginRows(); i < v.end(); i++, iX++)
+    sum += (*p_X_)(iX,j) * v[i];
+  return sum;
+}
+
+void ArrayDesign::addCol(int j, Real alpha, CVectorX &v) const
+{
+  for(int i = v.begin(), iX = p_X_->beginRows(); i < v.end(); i++, iX++)
+    v[i] += alpha * (*p_X_)(iX,j);
+}
+
+Real ArrayDesign::dotRows(int j, vector<int> const& rows, vector<int> const&, CVectorX const& v) const
+{
+  //the columns are contiguous: the values are gathered from the address of the column
+  Real const* col = &(*p_X_)(p_X_->beginRows(),j) - 1;
+  Real const* pv = &v[v.begin()];
+  int const* pRows = rows.empty() ? 0 : &rows[0];
+  int m = rows.size(), i = 0;
+  Real s0 = 0., s1 = 0.;
+  for( ; i + 2 <= m; i += 2)
+  {
+    s0 += col[pRows[i]] * pv[i];
+    s1 += col[pRows[i+1]] * pv[i+1];
+  }
+  if(i < m) { s0 += col[pRows[i]] * pv[i];}
+  return s0 + s1;
+}
+
+void ArrayDesign::addColRows(int j, vector<int> const& rows, vector<int> const&, Real alpha, CVectorX &v) const
+{
+  Real const* col = &(*p_X_)(p_X_->beginRows(),j) - 1;
+  Real* pv = &v[v.begin()];
+  for(int i = 0; i < (int) rows.size(); i++)
+    pv[i] += alpha * col[rows[i]];
+}
+
+void ArrayDesign::blockTransposeProduct(vector<CVectorX> const& V, vector<CVectorX> &A) const
+{
+  int p = p_X_->sizeCols();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(int j = 1; j <= p; j++)
+    blockDot(&(*p_X_)(p_X_->beginRows(),j), j, V, A);
+}
+
+Real ArrayDesign::colMean(int j) const
+{
+  Real sum = 0.;
+  for(int i = p_X_->beginRows(); i < p_X_->endRows(); i++)
+    sum += (*p_X_)(i,j);
+  return sum/p_X_->sizeRows();
+}
+
+IDesign* ArrayDesign::extractRows(vector<int> const& rows) const
+{
+  ArrayDesign* design = new ArrayDesign(rows.size(), p_X_->sizeCols());
+  for(int i = 0; i < (int) rows.size(); i++)
+    design->data_.row(i+1) = p_X_->row(rows[i]);
+  return design;
+}
+
+/*
+ * Constructor
+ * @param data pointer on the n*p values stored by column
+ * @param n number of individuals
+ * @param p number of variables
+ */
+BufferDesign::BufferDesign(Real const* data, int n, int p) : data_(data), n_(n), p_(p) {}
+
+Real BufferDesign::dot(int j, CVectorX const& v) const
+{
+  Real const* col = data_ + (size_t) (j-1) * n_;
+  Real sum = 0.;
+  for(int i = 0, iv = v.begin(); i < n_; i++, iv++)
+    sum += col[i] * v[iv];
+  return sum;
+}
+
+void BufferDesign::addCol(int j, Real alpha, CVectorX &v) const
+{
+  Real const* col = data_ + (size_t) (j-1) * n_;
+  for(int i = 0, iv = v.begin(); i < n_; i++, iv++)
+    v[iv] += alpha * col[i];
+}
+
+Real BufferDesign::dotRows(int j, vector<int> const& rows, vector<int> const&, CVectorX const& v) const
+{
+  Real const* col = data_ + (size_t) (j-1) * n_ - 1;
+  Real sum = 0.;
+  for(int i = 0, iv = v.begin(); i < (int) rows.size(); i++, iv++)
+    sum += col[rows[i]] * v[iv];
+  return sum;
+}
+
+void BufferDesign::addColRows(int j, vector<int> const& rows, vector<int> const&, Real alpha, CVectorX &v) const
+{
+  Real const* col = data_ + (size_t) (j-1) * n_ - 1;
+  for(int i = 0, iv = v.begin(); i < (int) rows.size(); i++, iv++)
+    v[iv] += alpha * col[rows[i]];
+}
+
+/* compute A[k] = X'*V[k]: the variables are processed in parallel, each one is read once*/
+void BufferDesign::blockTransposeProduct(vector<CVectorX> const& V, vector<CVectorX> &A) const
+{
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(int j = 1; j <= p_; j++)
+    blockDot(data_ + (size_t) (j-1) * n_, j, V, A);
+}
+
+Real BufferDesign::colMean(int j) const
+{
+  Real const* col = data_ + (size_t) (j-1) * n_;
+  Real sum = 0.;
+  for(int i = 0; i < n_; i++)
+    sum += col[i];
+  return sum/n_;
+}
+
+IDesign* BufferDesign::extractRows(vector<int> const& rows) const
+{
+  ArrayDesign* design = new ArrayDesign(rows.size(), p_);
+  CArrayXX& data = design->ownedData();
+  for(int j = 1; j <= p_; j++)
+  {
+    Real const* col = data_ + (size_t) (j-1) * n_;
+    for(int i = 0; i < (int) rows.size(); i++)
+      data(i+1,j) = col[rows[i]-1];
+  }
+  return design;
+}
+
+/*
+ * Constructor
+ * @param n number of individuals
+ * @param p number of variables
+ */
+FloatDesign::FloatDesign(int n, int p) : n_(n), p_(p), data_((size_t) n * p, 0.f), mean_(p+1, 0.) {}
+
+Real FloatDesign::dot(int j, CVectorX const& v) const
+{
+  float const* col = &data_[(size_t) (j-1) * n_];
+  Real sum = 0.;
+  for(int i = 0, iv = v.begin(); i < n_; i++, iv++)
+    sum += col[i] * v[iv];
+  return sum;
+}
+
+void FloatDesign::addCol(int j, Real alpha, CVectorX &v) const
+{
+  float const* col = &data_[(size_t) (j-1) * n_];
+  for(int i = 0, iv = v.begin(); i < n_; i++, iv++)
+    v[iv] += alpha * col[i];
+}
+
+Real FloatDesign::dotRows(int j, vector<int> const& rows, vector<int> const&, CVectorX const& v) const
+{
+  float const* col = &data_[(size_t) (j-1) * n_] - 1;
+  Real sum = 0.;
+  for(int i = 0, iv = v.begin(); i < (int) rows.size(); i++, iv++)
+    sum += col[rows[i]] * v[iv];
+  return sum;
+}
+
+void FloatDesign::addColRows(int j, vector<int> const& rows, vector<int> const&, Real alpha, CVectorX &v) const
+{
+  float const* col = &data_[(size_t) (j-1) * n_] - 1;
+  for(int i = 0, iv = v.begin(); i < (int) rows.size(); i++, iv++)
+    v[iv] += alpha * col[rows[i]];
+}
+
+/* compute A[k] = X'*V[k]: the variables are processed in parallel, each one is read once*/
+void FloatDesign::blockTransposeProduct(vector<CVectorX> const& V, vector<CVectorX> &A) const
+{
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(int j = 1; j <= p_; j++)
+    blockDot(&data_[(size_t) (j-1) * n_], j, V, A);
+}
+
+IDesign* FloatDesign::extractRows(vector<int> const& rows) const
+{
+  int n = rows.size();
+  FloatDesign* design = new FloatDesign(n, p_);
+  for(int j = 0; j < p_; j++)
+  {
+    float const* col = &data_[(size_t) j * n_];
+    float* newCol = &design->data_[(size_t) j * n];
+    for(int i = 0; i < n; i++)
+      newCol[i] = col[rows[i]-1];
+  }
+  design->computeMean();
+  return design;
+}
+
+/* compute the means of the columns (in double precision)*/
+void FloatDesign::computeMean()
+{
+  for(int j = 0; j < p_; j++)
+  {
+    float const* col = &data_[(size_t) j * n_];
+    Real sum = 0.;
+    for(int i = 0; i < n_; i++)
+      sum += col[i];
+    mean_[j+1] = (n_ > 0) ? sum/n_ : 0.;
+  }
+}
+
+/*
+ * Constructor, the data are copied
+ * @param n number of individuals
+ * @param p number of variables
+ * @param colPtr array of size p+1
+ * @param rowIdx array of size nnz, index (from 0) of the individual of each non-zero value
+ * @param values array of size nnz, non-zero values
+ */
+SparseDesign::SparseDesign(int n, int p, int const* colPtr, int const* rowIdx, double const* values)
+                          : n_(n), p_(p)
+                          , colPtr_(colPtr, colPtr + p + 1)
+                          , rowIdx_(colPtr[p]), values_(values, values + colPtr[p])
+                          , mean_(p+1, 0.)
+{
+  for(int k = 0; k < colPtr[p]; k++)
+    rowIdx_[k] = rowIdx[k] + 1;
+  computeMean();
+}
+
+/* Constructor of an empty design used by extractRows*/
+SparseDesign::SparseDesign(int n, int p) : n_(n), p_(p), colPtr_(p+1, 0), rowIdx_(), values_(), mean_(p+1, 0.) {}
+
+Real SparseDesign::elt(int i, int j) const
+{
+  for(int k = colPtr_[j-1]; k < colPtr_[j]; k++)
+    if(rowIdx_[k] == i) return values_[k];
+  return 0.;
+}
+
+Real SparseDesign::dot(int j, CVectorX const& v) const
+{
+  int shift = v.begin() - 1;
+  Real sum = 0.;
+  for(int k = colPtr_[j-1]; k < colPtr_[j]; k++)
+    sum += values_[k] * v[rowIdx_[k] + shift];
+  return sum;
+}
+
+void SparseDesign::addCol(int j, Real alpha, CVectorX &v) const
+{
+  int shift = v.begin() - 1;
+  for(int k = colPtr_[j-1]; k < colPtr_[j]; k++)
+    v[rowIdx_[k] + shift] += alpha * values_[k];
+}
+
+/* only the non-zero values of the column are read, their position in the subset is given by position*/
+Real SparseDesign::dotRows(int j, vector<int> const&, vector<int> const& position, CVectorX const& v) const
+{
+  int shift = v.begin() - 1;
+  Real sum = 0.;
+  for(int k = colPtr_[j-1]; k < colPtr_[j]; k++)
+  {
+    int i = position[rowIdx_[k]];
+    if(i != 0) sum += values_[k] * v[i + shift];
+  }
+  return sum;
+}
+
+void SparseDesign::addColRows(int j, vector<int> const&, vector<int> const& position, Real alpha, CVectorX &v) const
+{
+  int shift = v.begin() - 1;
+  for(int k = colPtr_[j-1]; k < colPtr_[j]; k++)
+  {
+    int i = position[rowIdx_[k]];
+    if(i != 0) v[i + shift] += alpha * values_[k];
+  }
+}
+
+IDesign* SparseDesign::extractRows(vector<int> const& rows) const
+{
+  //new index of each individual, 0 if the individual is not kept
+  vector<int> newRow(n_+1, 0);
+  for(int i = 0; i < (int) rows.size(); i++)
+    newRow[rows[i]] = i+1;
+
+  SparseDesign* design = new SparseDesign(rows.size(), p_);
+  for(int j = 0; j < p_; j++)
+  {
+    for(int k = colPtr_[j]; k < colPtr_[j+1]; k++)
+    {
+      if(newRow[rowIdx_[k]] != 0)
+      {
+        design->rowIdx_.push_back(newRow[rowIdx_[k]]);
+        design->values_.push_back(values_[k]);
+      }
+    }
+    design->colPtr_[j+1] = design->values_.size();
+  }
+  design->computeMean();
+  return design;
+}
+
+/* compute the means of the columns*/
+void SparseDesign::computeMean()
+{
+  for(int j = 1; j <= p_; j++)
+  {
+    Real sum = 0.;
+    for(int k = colPtr_[j-1]; k < colPtr_[j]; k++)
+      sum += values_[k];
+    mean_[j] = (n_ > 0) ? sum/n_ : 0.;
+  }
+}
+
+/*
+ * Constructor
+ * @param n number of individuals
+ * @param p number of variables
+ */
+GenotypeDesign::GenotypeDesign(int n, int p) : n_(n), p_(p), nbBytes_((n+3)/4), data_((size_t) nbBytes_ * p, 0), mean_(p+1, 0.) {}
+
+Real GenotypeDesign::elt(int i, int j) const
+{
+  Real values[4];
+  codeValues(j, values);
+  return values[code(i-1,j-1)];
+}
+
+Real GenotypeDesign::dot(int j, CVectorX const& v) const
+{
+  Real values[4];
+  codeValues(j, values);
+  unsigned char const* col = &data_[(size_t) (j-1) * nbBytes_];
+  int nbFullBytes = n_/4, iv = v.begin();
+  Real sum = 0.;
+  for(int b = 0; b < nbFullBytes; b++, iv += 4)
+  {
+    unsigned char c = col[b];
+    sum += values[c & 3] * v[iv] + values[(c >> 2) & 3] * v[iv+1]
+         + values[(c >> 4) & 3] * v[iv+2] + values[c >> 6] * v[iv+3];
+  }
+  for(int i = 4*nbFullBytes; i < n_; i++, iv++)
+    sum += values[code(i,j-1)] * v[iv];
+  return sum;
+}
+
+void GenotypeDesign::addCol(int j, Real alpha, CVectorX &v) const
+{
+  Real values[4];
+  codeValues(j, values);
+  for(int k = 0; k < 4; k++) values[k] *= alpha;
+  unsigned char const* col = &data_[(size_t) (j-1) * nbBytes_];
+  int nbFullBytes = n_/4, iv = v.begin();
+  for(int b = 0; b < nbFullBytes; b++, iv += 4)
+  {
+    unsigned char c = col[b];
+    v[iv]   += values[c & 3];
+    v[iv+1] += values[(c >> 2) & 3];
+    v[iv+2] += values[(c >> 4) & 3];
+    v[iv+3] += values[c >> 6];
+  }
+  for(int i = 4*nbFullBytes; i < n_; i++, iv++)
+    v[iv] += values[code(i,j-1)];
+}
+
+Real GenotypeDesign::dotRows(int j, vector<int> const& rows, vector<int> const&, CVectorX const& v) const
+{
+  Real values[4];
+  codeValues(j, values);
+  Real sum = 0.;
+  for(int i = 0, iv = v.begin(); i < (int) rows.size(); i++, iv++)
+    sum += values[code(rows[i]-1,j-1)] * v[iv];
+  return sum;
+}
+
+void GenotypeDesign::addColRows(int j, vector<int> const& rows, vector<int> const&, Real alpha, CVectorX &v) const
+{
+  Real values[4];
+  codeValues(j, values);
+  for(int k = 0; k < 4; k++) values[k] *= alpha;
+  for(int i = 0, iv = v.begin(); i < (int) rows.size(); i++, iv++)
+    v[iv] += values[code(rows[i]-1,j-1)];
+}
+
+IDesign* GenotypeDesign::extractRows(vector<int> const& rows) const
+{
+  GenotypeDesign* design = new GenotypeDesign(rows.size(), p_);
+  for(int j = 0; j < p_; j++)
+    for(int i = 0; i < (int) rows.size(); i++)
+      design->setCode(i, j, code(rows[i]-1, j));
+  design->computeMean();
+  return design;
+}
+
+/* compute the means of the columns without the missing values*/
+void GenotypeDesign::computeMean()
+{
+  for(int j = 0; j < p_; j++)
+  {
+    Real sum = 0.;
+    int nbObs = 0;
+    for(int i = 0; i < n_; i++)
+    {
+      unsigned char c = code(i,j);
+      if(c != missing_) { sum += c; nbObs++;}
+    }
+    mean_[j+1] = (nbObs > 0) ? sum/nbObs : 0.;
+  }
+}
+
+/*
+ * Constructor
+ * @param X design. X is not copied and must exist as long as the object
+ */
+FusionDesign::FusionDesign(IDesign const& X) : p_ownX_(0), p_X_(&X), mean_(X.sizeCols()+1, 0.)
+                                             , buffer_(X.sizeCols()+1, 0.)
+{ computeMean();}
+
+/* Constructor owning X, used by extractRows*/
+FusionDesign::FusionDesign(IDesign* X) : p_ownX_(X), p_X_(X), mean_(X->sizeCols()+1, 0.)
+                                       , buffer_(X->sizeCols()+1, 0.)
+{ computeMean();}
+
+/* destructor*/
+FusionDesign::~FusionDesign()
+{ if(p_ownX_) delete p_ownX_;}
+
+Real FusionDesign::elt(int i, int j) const
+{
+  Real sum = 0.;
+  for(int k = j; k <= p_X_->sizeCols(); k++)
+    sum += p_X_->elt(i,k);
+  return sum;
+}
+
+Real FusionDesign::dot(int j, CVectorX const& v) const
+{
+  Real sum = 0.;
+  for(int k = j; k <= p_X_->sizeCols(); k++)
+    sum += p_X_->dot(k,v);
+  return sum;
+}
+
+void FusionDesign::addCol(int j, Real alpha, CVectorX &v) const
+{
+  for(int k = j; k <= p_X_->sizeCols(); k++)
+    p_X_->addCol(k,alpha,v);
+}
+
+void FusionDesign::addCols(VectorXi const& idx, CVectorX const& alpha, CVectorX &v) const
+{
+  if(idx.size() == 0) return;
+  //sum_k alpha_k z_idx[k] = sum_m x_m (sum_{idx[k]<=m} alpha_k): the coefficient of x_m is a prefix sum
+  int p = p_X_->sizeCols(), first = p+1;
+  for(int k = idx.begin(), ka = alpha.begin(); k < idx.end(); k++, ka++)
+  {
+    buffer_[idx[k]] += alpha[ka];
+    first = std::min(first, idx[k]);
+  }
+  Real coeff = 0.;
+  for(int m = first; m <= p; m++)
+  {
+    coeff += buffer_[m];
+    buffer_[m] = 0.;
+    if(coeff != 0.) { p_X_->addCol(m,coeff,v);}
+  }
+}
+
+void FusionDesign::dotCols(VectorXi const& idx, CVectorX const& v, CVectorX &a) const
+{
+  if(idx.size() == 0) return;
+  //z_j'v = sum_{m>=j} x_m'v: the suffix sums are computed once from the smallest index
+  int p = p_X_->sizeCols(), first = p+1;
+  for(int k = idx.begin(); k < idx.end(); k++)
+    first = std::min(first, idx[k]);
+  Real sum = 0.;
+  for(int m = p; m >= first; m--)
+  {
+    sum += p_X_->dot(m,v);
+    buffer_[m] = sum;
+  }
+  for(int k = idx.begin(), ka = a.begin(); k < idx.end(); k++, ka++)
+    a[ka] = buffer_[idx[k]];
+  for(int m = first; m <= p; m++)
+    buffer_[m] = 0.;
+}
+
+void FusionDesign::transposeProduct(CVectorX const& v, CVectorX &a) const
+{
+  //a_j = sum_{k>=j} x_k'v
+  p_X_->transposeProduct(v,a);
+  for(int j = a.lastIdx()-1; j >= a.begin(); j--)
+    a[j] += a[j+1];
+}
+
+IDesign* FusionDesign::extractRows(vector<int> const& rows) const
+{ return new FusionDesign(p_X_->extractRows(rows));}
+
+/* compute the means of the columns*/
+void FusionDesign::computeMean()
+{
+  int p = p_X_->sizeCols();
+  if(p == 0) return;
+  mean_[p] = p_X_->colMean(p);
+  for(int j = p-1; j >= 1; j--)
+    mean_[j] = mean_[j+1] + p_X_->colMean(j);
+}
+
+/*
+ * Constructor
+ * @param X design. X is not copied and must exist as long as the object
+ * @param rows index of the individuals of the subset, in increasing order
+ */
+RowSubsetDesign::RowSubsetDesign(IDesign const& X, vector<int> const& rows)
+                                : p_X_(&X), rows_(rows), position_(X.sizeRows()+1, 0), mean_(Range(1,X.sizeCols()), 0.)
+                                , missingPtr_(), missingPos_(), delta_(), buffer_()
+{
+  if(!p_X_->hasCheapColumns())
+  {
+    buffer_.resize(Range(1,X.sizeRows()));
+    buffer_ = 0.;
+  }
+  for(int i = 0; i < (int) rows_.size(); i++)
+    position_[rows_[i]] = i+1;
+  if(rows_.empty()) return;
+  if(p_X_->hasMissingValues())
+  {
+    computeMissing();
+    return;
+  }
+  CVectorX one(Range(1,rows_.size()), 1.);
+  transposeProduct(one, mean_);
+  for(int j = mean_.begin(); j < mean_.end(); j++)
+    mean_[j] /= rows_.size();
+}
+
+/* compute the means of the observed values of the subset and store the missing values*/
+void RowSubsetDesign::computeMissing()
+{
+  int p = p_X_->sizeCols();
+  missingPtr_.assign(p+1, 0);
+  delta_.assign(p+1, 0.);
+  for(int j = 1; j <= p; j++)
+  {
+    Real sum = 0., missingValue = 0.;
+    int nbObs = 0;
+    for(int i = 0; i < (int) rows_.size(); i++)
+    {
+      if(p_X_->isMissing(rows_[i],j))
+      {
+        missingPos_.push_back(i+1);
+        missingValue = p_X_->elt(rows_[i],j);
+      }
+      else
+      {
+        sum += p_X_->elt(rows_[i],j);
+        nbObs++;
+      }
+    }
+    missingPtr_[j] = missingPos_.size();
+    //the missing values are equal to the mean of the observed values, as the other values in average
+    mean_[j] = (nbObs > 0) ? sum/nbObs : 0.;
+    if(missingPtr_[j] > missingPtr_[j-1]) { delta_[j] = mean_[j] - missingValue;}
+  }
+}
+
+Real RowSubsetDesign::elt(int i, int j) const
+{
+  if(!missingPos_.empty() && p_X_->isMissing(rows_[i-1],j)) return mean_[j];
+  return p_X_->elt(rows_[i-1],j);
+}
+
+Real RowSubsetDesign::dot(int j, CVectorX const& v) const
+{
+  Real sum = p_X_->dotRows(j,rows_,position_,v);
+  if(missingPos_.empty()) return sum;
+  //the missing values of the whole design are replaced by the mean of the subset
+  Real sumMissing = 0.;
+  for(int k = missingPtr_[j-1]; k < missingPtr_[j]; k++)
+    sumMissing += v[v.begin() + missingPos_[k] - 1];
+  return sum + delta_[j] * sumMissing;
+}
+
+void RowSubsetDesign::addCol(int j, Real alpha, CVectorX &v) const
+{
+  p_X_->addColRows(j,rows_,position_,alpha,v);
+  if(missingPos_.empty()) return;
+  Real shift = alpha * delta_[j];
+  for(int k = missingPtr_[j-1]; k < missingPtr_[j]; k++)
+    v[v.begin() + missingPos_[k] - 1] += shift;
+}
+
+void RowSubsetDesign::transposeProduct(CVectorX const& v, CVectorX &a) const
+{
+  if(p_X_->hasCheapColumns())
+  {
+    for(int j = a.begin(); j < a.end(); j++)
+      a[j] = dot(j,v);
+    return;
+  }
+  //the product of the whole design is computed once, with v equal to 0 outside the subset. buffer_
+  //is reset on the subset only
+  for(int i = 0, iv = v.begin(); i < (int) rows_.size(); i++, iv++)
+    buffer_[rows_[i]] = v[iv];
+  p_X_->transposeProduct(buffer_,a);
+  for(int i = 0; i < (int) rows_.size(); i++)
+    buffer_[rows_[i]] = 0.;
+  if(missingPos_.empty()) return;
+  for(int j = a.begin(); j < a.end(); j++)
+  {
+    Real sumMissing = 0.;
+    for(int k = missingPtr_[j-1]; k < missingPtr_[j]; k++)
+      sumMissing += v[v.begin() + missingPos_[k] - 1];
+    a[j] += delta_[j] * sumMissing;
+  }
+}
+
+IDesign* RowSubsetDesign::extractRows(vector<int> const& rows) const
+{
+  vector<int> subRows(rows.size());
+  for(int i = 0; i < (int) rows.size(); i++)
+    subRows[i] = rows_[rows[i]-1];
+  return new RowSubsetDesign(*p_X_, subRows);
+}
+
+void ActiveColumns::product(CVectorX const& w, CVectorX &u) const
+{
+  STK::VectorXi const& idx = *p_idx_;
+  CVectorX const& muX = *p_muX_;
+  u.resize(Range(1,p_X_->sizeRows()));
+  u = 0.;
+  //the mean of the variables is subtracted once at the end
+  p_X_->addCols(idx,w,u);
+  Real shift = 0.;
+  for(int k = idx.begin(), kw = w.begin(); k < idx.end(); k++, kw++)
+    shift += muX[idx[k]] * w[kw];
+  u -= shift;
+}
+
+void ActiveColumns::transposeProduct(CVectorX const& v, CVectorX &a) const
+{
+  STK::VectorXi const& idx = *p_idx_;
+  CVectorX const& muX = *p_muX_;
+  Real sumV = v.sum();
+  p_X_->dotCols(idx,v,a);
+  for(int k = idx.begin(), ka = a.begin(); k < idx.end(); k++, ka++)
+    a[ka] -= muX[idx[k]] * sumV;
+}
+
+}//end namespace HD
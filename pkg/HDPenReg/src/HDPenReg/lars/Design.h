@@ -0,0 +1,644 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file Design.h
+ *  @brief In this file, we define the interface @c IDesign for the design
+ *  matrix of the lars algorithm and its dense, sparse, genotype, fusion and row subset implementations.
+ **/
+
+
+#ifndef DESIGN_H_
+#define DESIGN_H_
+
+namespace HD
+{
+/**
+ * Interface for the design matrix used by the lars algorithm.
+ *
+ * The lars algorithm only accesses the design by columns: products x_j'v,
+ * updates v += alpha*x_j and means of the columns. The storage of the data
+ * (double, float, sparse...) is hidden behind this interface and the
+ * computations are always done in double precision.
+ * Rows and columns are indexed from 1.
+ */
+  class IDesign
+  {
+    public:
+      /** destructor*/
+      virtual ~IDesign() {}
+      /** @return the number of individuals*/
+      virtual int sizeRows() const = 0;
+      /** @return the number of variables*/
+      virtual int sizeCols() const = 0;
+      /**
+       * @param i index of the individual
+       * @param j index of the variable
+       * @return the value of the j-th variable for the i-th individual
+       */
+      virtual STK::Real elt(int i, int j) const = 0;
+      /**
+       * @param j index of the variable
+       * @param v vector of size n
+       * @return x_j'*v
+       */
+      virtual STK::Real dot(int j, STK::CVectorX const& v) const = 0;
+      /**
+       * compute v += alpha*x_j
+       * @param j index of the variable
+       * @param alpha coefficient
+       * @param v vector of size n
+       */
+      virtual void addCol(int j, STK::Real alpha, STK::CVectorX &v) const = 0;
+      /**
+       * @param j index of the variable
+       * @param rows index of a subset of individuals, in increasing order
+       * @param position position of each individual in rows (from 1, 0 if not in the subset), size n+1
+       * @param v vector of size rows.size()
+       * @return x_j[rows]'*v
+       */
+      virtual STK::Real dotRows( int j, std::vector<int> const& rows, std::vector<int> const& /*position*/
+                               , STK::CVectorX const& v) const
+      {
+        STK::Real sum = 0.;
+        for(int i = 0, iv = v.begin(); i < (int) rows.size(); i++, iv++)
+          sum += elt(rows[i],j) * v[iv];
+        return sum;
+      }
+      /**
+       * compute v += alpha*x_j[rows]
+       * @param j index of the variable
+       * @param rows index of a subset of individuals, in increasing order
+       * @param position position of each individual in rows (from 1, 0 if not in the subset), size n+1
+       * @param alpha coefficient
+       * @param v vector of size rows.size()
+       */
+      virtual void addColRows( int j, std::vector<int> const& rows, std::vector<int> const& /*position*/
+                             , STK::Real alpha, STK::CVectorX &v) const
+      {
+        for(int i = 0, iv = v.begin(); i < (int) rows.size(); i++, iv++)
+          v[iv] += alpha * elt(rows[i],j);
+      }
+      /**
+       * compute v += sum_k alpha[k]*x_idx[k] for a set of variables
+       * @param idx index of the variables
+       * @param alpha coefficients, the first idx.size() elements are used
+       * @param v vector of size n
+       */
+      virtual void addCols(STK::VectorXi const& idx, STK::CVectorX const& alpha, STK::CVectorX &v) const
+      {
+        for(int k = idx.begin(), ka = alpha.begin(); k < idx.end(); k++, ka++)
+          addCol(idx[k],alpha[ka],v);
+      }
+      /**
+       * compute a[k] = x_idx[k]'*v for a set of variables
+       * @param idx index of the variables
+       * @param v vector of size n
+       * @param a result, the first idx.size() elements are computed
+       */
+      virtual void dotCols(STK::VectorXi const& idx, STK::CVectorX const& v, STK::CVectorX &a) const
+      {
+        for(int k = idx.begin(), ka = a.begin(); k < idx.end(); k++, ka++)
+          a[ka] = dot(idx[k],v);
+      }
+      /**
+       * compute a = X'*v
+       * @param v vector of size n
+       * @param a vector of size p
+       */
+      virtual void transposeProduct(STK::CVectorX const& v, STK::CVectorX &a) const
+      {
+        for(int j = a.begin(); j < a.end(); j++)
+          a[j] = dot(j,v);
+      }
+      /**
+       * compute A[k] = X'*V[k] for several vectors. With cheap columns, each
+       * variable is read once for all the vectors.
+       * @param V vectors of size n
+       * @param A vectors of size p, one for each vector of V
+       */
+      virtual void blockTransposeProduct(std::vector<STK::CVectorX> const& V, std::vector<STK::CVectorX> &A) const
+      {
+        if(!hasCheapColumns())
+        {
+          for(int k = 0; k < (int) V.size(); k++)
+            transposeProduct(V[k],A[k]);
+          return;
+        }
+        int p = sizeCols();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for(int j = 1; j <= p; j++)
+          for(int k = 0; k < (int) V.size(); k++)
+            A[k][j] = dot(j,V[k]);
+      }
+      /**
+       * @return true if dot(j,v) costs as much as reading the j-th variable. If false,
+       * X'*v must be computed with transposeProduct.
+       */
+      virtual bool hasCheapColumns() const {return true;}
+      /**
+       * @return true if the design has missing values. A missing value is replaced by the mean of the
+       * observed values of the variable, see @c RowSubsetDesign for the views on the individuals.
+       */
+      virtual bool hasMissingValues() const {return false;}
+      /**
+       * @param i index of the individual
+       * @param j index of the variable
+       * @return true if x_ij is a missing value
+       */
+      virtual bool isMissing(int /*i*/, int /*j*/) const {return false;}
+      /**
+       * @param j index of the variable
+       * @return the mean of the j-th variable
+       */
+      virtual STK::Real colMean(int j) const = 0;
+      /**
+       * create a design containing a subset of the individuals, with the same storage.
+       * @param rows index of the individuals to keep
+       * @return a pointer on the new design, it must be deleted by the caller
+       */
+      virtual IDesign* extractRows(std::vector<int> const& rows) const = 0;
+  };
+
+/**
+ * compute A[k][j] = x_j'*V[k] for all the vectors of V, x_j being stored in a contiguous
+ * column. The vectors are processed four at a time, so each value of the column is read
+ * once for four vectors. The sums are done in the same order as a single dot product.
+ * @param col address of the column x_j
+ * @param j index of the variable
+ * @param V vectors of size n
+ * @param A vectors of size p, one for each vector of V
+ */
+  template<class Type>
+  void blockDot(Type const* col, int j, std::vector<STK::CVectorX> const& V, std::vector<STK::CVectorX> &A)
+  {
+    int k = 0, m = V.size();
+    for( ; k + 4 <= m; k += 4)
+    {
+      int n = V[k].size();
+      STK::Real const *v0 = &V[k][V[k].begin()], *v1 = &V[k+1][V[k+1].begin()]
+                    , *v2 = &V[k+2][V[k+2].begin()], *v3 = &V[k+3][V[k+3].begin()];
+      STK::Real s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+      for(int i = 0; i < n; i++)
+      {
+        STK::Real x = col[i];
+        s0 += x * v0[i]; s1 += x * v1[i]; s2 += x * v2[i]; s3 += x * v3[i];
+      }
+      A[k][j] = s0; A[k+1][j] = s1; A[k+2][j] = s2; A[k+3][j] = s3;
+    }
+    for( ; k < m; k++)
+    {
+      int n = V[k].size();
+      STK::Real const *v = &V[k][V[k].begin()];
+      STK::Real sum = 0.;
+      for(int i = 0; i < n; i++)
+        sum += col[i] * v[i];
+      A[k][j] = sum;
+    }
+  }
+
+/**
+ * Design stored in a STK::CArrayXX.
+ */
+  class ArrayDesign : public IDesign
+  {
+    public:
+      /**
+       * Constructor
+       * @param X matrix of data, a row=a individual. X is not copied and must exist as long as the object
+       */
+      ArrayDesign(STK::CArrayXX const& X);
+      /**
+       * Constructor, the design owns its data
+       * @param n number of individuals
+       * @param p number of variables
+       */
+      ArrayDesign(int n, int p);
+
+      /** @return the data*/
+      inline STK::CArrayXX const& data() const {return *p_X_;}
+      /** @return the data of a design constructed with its dimensions*/
+      inline STK::CArrayXX& ownedData() {return data_;}
+      inline virtual int sizeRows() const {return p_X_->sizeRows();}
+      inline virtual int sizeCols() const {return p_X_->sizeCols();}
+      inline virtual STK::Real elt(int i, int j) const {return (*p_X_)(i,j);}
+      virtual STK::Real dot(int j, STK::CVectorX const& v) const;
+      virtual void addCol(int j, STK::Real alpha, STK::CVectorX &v) const;
+      virtual STK::Real dotRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::CVectorX const& v) const;
+      virtual void addColRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::Real alpha, STK::CVectorX &v) const;
+      virtual void blockTransposeProduct(std::vector<STK::CVectorX> const& V, std::vector<STK::CVectorX> &A) const;
+      virtual STK::Real colMean(int j) const;
+      virtual IDesign* extractRows(std::vector<int> const& rows) const;
+
+    private:
+      /** no copy: p_X_ can point on data_*/
+      ArrayDesign(ArrayDesign const&);
+      ArrayDesign& operator=(ArrayDesign const&);
+      /// data, used only if the design owns its data
+      STK::CArrayXX data_;
+      /// pointer on the data
+      STK::CArrayXX const* p_X_;
+  };
+
+/**
+ * Design on a column-major buffer of double owned by the caller, typically the
+ * memory of a R matrix. The data are read only and never copied.
+ */
+  class BufferDesign : public IDesign
+  {
+    public:
+      /**
+       * Constructor
+       * @param data pointer on the n*p values stored by column. data must exist as long as the object
+       * @param n number of individuals
+       * @param p number of variables
+       */
+      BufferDesign(STK::Real const* data, int n, int p);
+
+      inline virtual int sizeRows() const {return n_;}
+      inline virtual int sizeCols() const {return p_;}
+      inline virtual STK::Real elt(int i, int j) const {return data_[(size_t) (j-1) * n_ + i-1];}
+      virtual STK::Real dot(int j, STK::CVectorX const& v) const;
+      virtual void addCol(int j, STK::Real alpha, STK::CVectorX &v) const;
+      virtual STK::Real dotRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::CVectorX const& v) const;
+      virtual void addColRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::Real alpha, STK::CVectorX &v) const;
+      virtual void blockTransposeProduct(std::vector<STK::CVectorX> const& V, std::vector<STK::CVectorX> &A) const;
+      virtual STK::Real colMean(int j) const;
+      virtual IDesign* extractRows(std::vector<int> const& rows) const;
+
+    private:
+      /// pointer on the data
+      STK::Real const* data_;
+      /// number of individuals
+      int n_;
+      /// number of variables
+      int p_;
+  };
+
+/**
+ * Design stored in single precision. The memory used by the data is halved,
+ * the computations are done in double precision.
+ */
+  class FloatDesign : public IDesign
+  {
+    public:
+      /**
+       * Constructor, the data are converted in single precision
+       * @param X matrix of data, a row=a individual
+       */
+      template<class Array>
+      FloatDesign(Array const& X)
+                 : n_(X.sizeRows()), p_(X.sizeCols())
+                 , data_((size_t) n_ * p_), mean_(p_+1, 0.)
+      {
+        for(int j = 0; j < p_; j++)
+        {
+          float* col = &data_[(size_t) j * n_];
+          for(int i = 0; i < n_; i++)
+            col[i] = (float) X(X.beginRows()+i, X.beginCols()+j);
+        }
+        computeMean();
+      }
+      /**
+       * Constructor
+       * @param n number of individuals
+       * @param p number of variables
+       */
+      FloatDesign(int n, int p);
+
+      inline virtual int sizeRows() const {return n_;}
+      inline virtual int sizeCols() const {return p_;}
+      inline virtual STK::Real elt(int i, int j) const {return data_[(size_t) (j-1) * n_ + i-1];}
+      virtual STK::Real dot(int j, STK::CVectorX const& v) const;
+      virtual void addCol(int j, STK::Real alpha, STK::CVectorX &v) const;
+      virtual STK::Real dotRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::CVectorX const& v) const;
+      virtual void addColRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::Real alpha, STK::CVectorX &v) const;
+      virtual void blockTransposeProduct(std::vector<STK::CVectorX> const& V, std::vector<STK::CVectorX> &A) const;
+      inline virtual STK::Real colMean(int j) const {return mean_[j];}
+      virtual IDesign* extractRows(std::vector<int> const& rows) const;
+
+    private:
+      /** compute the means of the columns (in double precision)*/
+      void computeMean();
+      ///number of individuals
+      int n_;
+      ///number of variables
+      int p_;
+      ///data stored by column
+      std::vector<float> data_;
+      ///mean of the columns (index from 1)
+      std::vector<STK::Real> mean_;
+  };
+/**
+ * Sparse design stored in compressed sparse column (CSC) format, as the
+ * dgCMatrix of the R package Matrix. Only the non-zero values are used
+ * in the products, the centering is done by the lars algorithm.
+ */
+  class SparseDesign : public IDesign
+  {
+    public:
+      /**
+       * Constructor, the data are copied
+       * @param n number of individuals
+       * @param p number of variables
+       * @param colPtr array of size p+1, the non-zero values of the j-th variable (j from 0)
+       * are stored from colPtr[j] to colPtr[j+1]-1
+       * @param rowIdx array of size nnz, index (from 0) of the individual of each non-zero value
+       * @param values array of size nnz, non-zero values
+       */
+      SparseDesign(int n, int p, int const* colPtr, int const* rowIdx, double const* values);
+
+      inline virtual int sizeRows() const {return n_;}
+      inline virtual int sizeCols() const {return p_;}
+      virtual STK::Real elt(int i, int j) const;
+      virtual STK::Real dot(int j, STK::CVectorX const& v) const;
+      virtual void addCol(int j, STK::Real alpha, STK::CVectorX &v) const;
+      virtual STK::Real dotRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::CVectorX const& v) const;
+      virtual void addColRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::Real alpha, STK::CVectorX &v) const;
+      inline virtual STK::Real colMean(int j) const {return mean_[j];}
+      virtual IDesign* extractRows(std::vector<int> const& rows) const;
+      /** @return the number of non-zero values*/
+      inline int nbNonZero() const {return values_.size();}
+
+    private:
+      /** Constructor of an empty design used by extractRows*/
+      SparseDesign(int n, int p);
+      /** compute the means of the columns*/
+      void computeMean();
+      ///number of individuals
+      int n_;
+      ///number of variables
+      int p_;
+      ///start of each column in rowIdx_ and values_ (size p+1)
+      std::vector<int> colPtr_;
+      ///index of the individual (from 1) of each non-zero value
+      std::vector<int> rowIdx_;
+      ///non-zero values
+      std::vector<STK::Real> values_;
+      ///mean of the columns (index from 1)
+      std::vector<STK::Real> mean_;
+  };
+
+/**
+ * Design of genotypes (0, 1, 2 or missing value) packed on 2 bits: a byte
+ * contains the genotypes of 4 individuals and the memory used is 32 times
+ * lower than with a STK::CArrayXX. The genotypes are decoded on the fly with
+ * a table of the values of the 4 codes. A missing value is replaced by the
+ * mean of the variable.
+ */
+  class GenotypeDesign : public IDesign
+  {
+    public:
+      /**
+       * Constructor, the data are packed. A value different from 0, 1 and 2 (NaN)
+       * is a missing value.
+       * @param X matrix of genotypes, a row=a individual
+       */
+      template<class Array>
+      GenotypeDesign(Array const& X)
+                    : n_(X.sizeRows()), p_(X.sizeCols()), nbBytes_((n_+3)/4)
+                    , data_((size_t) nbBytes_ * p_, 0), mean_(p_+1, 0.)
+      {
+        for(int j = 0; j < p_; j++)
+          for(int i = 0; i < n_; i++)
+          {
+            STK::Real x = X(X.beginRows()+i, X.beginCols()+j);
+            unsigned char code = (x == 0.) ? 0 : (x == 1.) ? 1 : (x == 2.) ? 2 : missing_;
+            setCode(i, j, code);
+          }
+        computeMean();
+      }
+      /**
+       * Constructor
+       * @param n number of individuals
+       * @param p number of variables
+       */
+      GenotypeDesign(int n, int p);
+
+      inline virtual int sizeRows() const {return n_;}
+      inline virtual int sizeCols() const {return p_;}
+      virtual STK::Real elt(int i, int j) const;
+      virtual STK::Real dot(int j, STK::CVectorX const& v) const;
+      virtual void addCol(int j, STK::Real alpha, STK::CVectorX &v) const;
+      virtual STK::Real dotRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::CVectorX const& v) const;
+      virtual void addColRows(int j, std::vector<int> const& rows, std::vector<int> const& position, STK::Real alpha, STK::CVectorX &v) const;
+      inline virtual bool hasMissingValues() const {return true;}
+      inline virtual bool isMissing(int i, int j) const {return code(i-1,j-1) == missing_;}
+      inline virtual STK::Real colMean(int j) const {return mean_[j];}
+      virtual IDesign* extractRows(std::vector<int> const& rows) const;
+
+    private:
+      /** code of a missing value*/
+      static const unsigned char missing_ = 3;
+      /**
+       * @param i index of the individual (from 0)
+       * @param j index of the variable (from 0)
+       * @return the code of the genotype
+       */
+      inline unsigned char code(int i, int j) const
+      { return (data_[(size_t) j * nbBytes_ + i/4] >> (2*(i%4))) & 3;}
+      /**
+       * set the code of a genotype
+       * @param i index of the individual (from 0)
+       * @param j index of the variable (from 0)
+       * @param code code of the genotype
+       */
+      inline void setCode(int i, int j, unsigned char code)
+      { data_[(size_t) j * nbBytes_ + i/4] |= (unsigned char) (code << (2*(i%4)));}
+      /**
+       * fill the values of the 4 codes for a variable
+       * @param j index of the variable
+       * @param values values of the codes 0, 1, 2 and of a missing value
+       */
+      inline void codeValues(int j, STK::Real values[4]) const
+      { values[0] = 0.; values[1] = 1.; values[2] = 2.; values[3] = mean_[j];}
+      /** compute the means of the columns without the missing values*/
+      void computeMean();
+      ///number of individuals
+      int n_;
+      ///number of variables
+      int p_;
+      ///number of bytes of a column
+      int nbBytes_;
+      ///genotypes stored by column, 4 individuals by byte
+      std::vector<unsigned char> data_;
+      ///mean of the columns (index from 1)
+      std::vector<STK::Real> mean_;
+  };
+
+/**
+ * Design Z = X*L^-1 of the fusion problem (L^-1 = lower triangular matrix of 1),
+ * the j-th variable of Z is the sum of the variables j to p of X. Z is not stored,
+ * the products are computed from X: X'v is computed once and summed.
+ */
+  class FusionDesign : public IDesign
+  {
+    public:
+      /**
+       * Constructor
+       * @param X design. X is not copied and must exist as long as the object
+       */
+      FusionDesign(IDesign const& X);
+      /** destructor*/
+      virtual ~FusionDesign();
+
+      inline virtual int sizeRows() const {return p_X_->sizeRows();}
+      inline virtual int sizeCols() const {return p_X_->sizeCols();}
+      virtual STK::Real elt(int i, int j) const;
+      virtual STK::Real dot(int j, STK::CVectorX const& v) const;
+      virtual void addCol(int j, STK::Real alpha, STK::CVectorX &v) const;
+      /** compute v += sum_k alpha[k]*z_idx[k] in a single pass over the columns of X from min(idx)*/
+      virtual void addCols(STK::VectorXi const& idx, STK::CVectorX const& alpha, STK::CVectorX &v) const;
+      /** compute a[k] = z_idx[k]'*v in a single pass over the columns of X from min(idx)*/
+      virtual void dotCols(STK::VectorXi const& idx, STK::CVectorX const& v, STK::CVectorX &a) const;
+      virtual void transposeProduct(STK::CVectorX const& v, STK::CVectorX &a) const;
+      inline virtual bool hasCheapColumns() const {return false;}
+      inline virtual STK::Real colMean(int j) const {return mean_[j];}
+      virtual IDesign* extractRows(std::vector<int> const& rows) const;
+
+    private:
+      /** Constructor owning X, used by extractRows*/
+      FusionDesign(IDesign* X);
+      /** no copy*/
+      FusionDesign(FusionDesign const&);
+      FusionDesign& operator=(FusionDesign const&);
+      /** compute the means of the columns*/
+      void computeMean();
+      ///design owned by the object, NULL if X is not owned
+      IDesign* p_ownX_;
+      ///pointer on the design X
+      IDesign const* p_X_;
+      ///mean of the columns of Z (index from 1)
+      std::vector<STK::Real> mean_;
+      ///coefficients of the columns of X in addCols and dotCols (index from 1). The design is used
+      ///by a single lars algorithm at a time (see @c Fusion)
+      mutable std::vector<STK::Real> buffer_;
+  };
+
+/**
+ * View on a subset of the individuals of a design, used for the folds of the cross validation.
+ * Only the index of the individuals are stored: the folds share the data of the whole design,
+ * whatever the number of folds run at the same time.
+ *
+ * If the design has missing values, they are replaced by the mean of the observed values of the
+ * subset, as in a design extracted with extractRows, and not by the mean of the whole design: the
+ * control individuals of a fold do not see the values of the test individuals. The position of
+ * the missing values of the subset are stored with the difference of the two means.
+ */
+  class RowSubsetDesign : public IDesign
+  {
+    public:
+      /**
+       * Constructor
+       * @param X design. X is not copied and must exist as long as the object
+       * @param rows index of the individuals of the subset, in increasing order
+       */
+      RowSubsetDesign(IDesign const& X, std::vector<int> const& rows);
+
+      inline virtual int sizeRows() const {return rows_.size();}
+      inline virtual int sizeCols() const {return p_X_->sizeCols();}
+      virtual STK::Real elt(int i, int j) const;
+      virtual STK::Real dot(int j, STK::CVectorX const& v) const;
+      virtual void addCol(int j, STK::Real alpha, STK::CVectorX &v) const;
+      virtual void transposeProduct(STK::CVectorX const& v, STK::CVectorX &a) const;
+      inline virtual bool hasCheapColumns() const {return p_X_->hasCheapColumns();}
+      inline virtual bool hasMissingValues() const {return !missingPos_.empty();}
+      inline virtual bool isMissing(int i, int j) const {return p_X_->isMissing(rows_[i-1],j);}
+      inline virtual STK::Real colMean(int j) const {return mean_[j];}
+      virtual IDesign* extractRows(std::vector<int> const& rows) const;
+
+    private:
+      /** compute the means of the observed values of the subset and store the missing values*/
+      void computeMissing();
+      ///pointer on the whole design
+      IDesign const* p_X_;
+      ///index of the individuals of the subset in the whole design
+      std::vector<int> rows_;
+      ///position of each individual of the whole design in rows_ (from 1, 0 if not in the subset)
+      std::vector<int> position_;
+      ///mean of the columns (index from 1)
+      STK::CVectorX mean_;
+      ///the missing values of the j-th variable are stored from missingPtr_[j-1] to missingPtr_[j]-1
+      ///(empty if the design has no missing value)
+      std::vector<int> missingPtr_;
+      ///position in the subset (from 1) of each missing value
+      std::vector<int> missingPos_;
+      ///mean of the subset minus the value of the missing values in the whole design (index from 1)
+      std::vector<STK::Real> delta_;
+      ///vector of the size of the whole design, 0 outside the subset, used by transposeProduct if the
+      ///columns of the design are not cheap (empty otherwise). The view is used by a single lars
+      ///algorithm at a time (see @c Cvlars)
+      mutable STK::CVectorX buffer_;
+  };
+
+/**
+ * View on the active variables of a design, centered with the mean of the variables.
+ * Only the index of the active variables are stored: the products with the active
+ * variables are computed from the columns of the design, which are never copied.
+ */
+  class ActiveColumns
+  {
+    public:
+      /**
+       * Constructor
+       * @param X design. X is not copied and must exist as long as the object
+       * @param muX mean of the variables of X, must exist as long as the object
+       * @param idx index of the active variables, must exist as long as the object
+       */
+      ActiveColumns(IDesign const& X, STK::CVectorX const& muX, STK::VectorXi const& idx)
+                   : p_X_(&X), p_muX_(&muX), p_idx_(&idx) {}
+
+      /**@return the number of active variables*/
+      inline int size() const {return p_idx_->size();}
+      /**
+       * compute u = Xa*w with Xa the centered active variables
+       * @param w vector of size the number of active variables
+       * @param u result of size n
+       */
+      void product(STK::CVectorX const& w, STK::CVectorX &u) const;
+      /**
+       * compute a = Xa'*v with Xa the centered active variables
+       * @param v vector of size n
+       * @param a result of size the number of active variables
+       */
+      void transposeProduct(STK::CVectorX const& v, STK::CVectorX &a) const;
+
+    private:
+      ///pointer on the design
+      IDesign const* p_X_;
+      ///pointer on the mean of the variables
+      STK::CVectorX const* p_muX_;
+      ///pointer on the index of the active variables
+      STK::VectorXi const* p_idx_;
+  };
+}//end namespace HD
+
+#endif /* DESIGN_H_ */
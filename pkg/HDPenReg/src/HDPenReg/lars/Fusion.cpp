@@ -47,10 +47,13 @@ namespace HD
  */
 Fusion::Fusion(CArrayXX const& X, CVectorX const& y, bool intercept)
               : X_(X)
+              , p_Z_(0)
               , y_(y)
               , eps_(Arithmetic<Real>::epsilon())
               , path_(maxSteps_)
+              , rss_()
               , intercept_(intercept)
+              , timings_()
 {
   maxSteps_ = 3*min(X.sizeRows(),X.sizeCols());
   computeZ();
@@ -65,19 +68,45 @@ Fusion::Fusion(CArrayXX const& X, CVectorX const& y, bool intercept)
  */
 Fusion::Fusion( CArrayXX const& X, CVectorX const& y, int maxSteps, bool intercept, Real eps)
               : X_(X)
+              , p_Z_(0)
               , y_(y)
               , maxSteps_(maxSteps)
               , eps_(eps)
               , path_(maxSteps)
+              , rss_()
               , intercept_(intercept)
+              , timings_()
 { computeZ();}
 
+/*
+ * @param X design of size n*p, a row contains the values of each covariate for an individual.
+ * @param y vector of length n containing the response
+ * @param maxSteps number of maximum step to do
+ * @param eps epsilon (for 0)
+ */
+Fusion::Fusion( IDesign const& X, CVectorX const& y, int maxSteps, bool intercept, Real eps)
+              : X_()
+              , p_Z_(new FusionDesign(X))
+              , y_(y)
+              , maxSteps_(maxSteps)
+              , eps_(eps)
+              , path_(maxSteps)
+              , rss_()
+              , intercept_(intercept)
+              , timings_()
+{}
+
+/* destructor*/
+Fusion::~Fusion()
+{ if(p_Z_) delete p_Z_;}
+
   //methods
   /*
    * change X in Z=X*L^-1 (L^-1 = lower triangular matrix of 1)
    */
 void Fusion::computeZ()
 {
+  Timings::Timer timer(timings_, Timings::initialization);
   //int p=X_.sizeCols(), n=X_.sizeRows();
   for(int i=X_.lastIdxCols()-1; i>=X_.beginCols(); i--)
   {
@@ -85,6 +114,7 @@ void Fusion::computeZ()
 //    for(int j=X_.beginRows(); j<X_.endRows(); j++ )
 //      X_(j,i) += X_(j,i+1);
   }
+  p_Z_ = new ArrayDesign(X_);
 }
 
 /*
@@ -93,16 +123,18 @@ void Fusion::computeZ()
 void Fusion::run()
 {
   //run lars algorithm on Z
-  Lars lars(X_, y_, maxSteps_, intercept_, eps_);
+  Lars lars(*p_Z_, y_, maxSteps_, intercept_, eps_);
   lars.run();
 
   //get the solution path
   path_     =lars.path();
+  rss_      =lars.rss();
   step_     =lars.step();
   mu_       =lars.mu();
   muX_      =lars.muX();
   toIgnore_ =lars.toIgnore();
   msg_error_=lars.msg_error();
+  timings_ +=lars.timings();
 }
 
 }//end namespace
@@ -79,10 +79,24 @@ namespace HD
        */
       Fusion(STK::CArrayXX const& X, STK::CVectorX const& y, int maxSteps, bool intercept = true, STK::Real eps =STK::Arithmetic<STK::Real>::epsilon());
 
+      /**
+       * constructor. Z=X*L^-1 is not computed, the lars algorithm uses a @c FusionDesign on X.
+       * @param X design of size n*p, a row contains the values of each covariate for an individual.
+       * X is not copied and must exist as long as the object
+       * @param y vector of length n containing the response
+       * @param maxSteps number of maximum step to do
+       * @param intercept if true, there is an intercept in the model
+       * @param eps epsilon (for 0)
+       */
+      Fusion(IDesign const& X, STK::CVectorX const& y, int maxSteps, bool intercept = true, STK::Real eps =STK::Arithmetic<STK::Real>::epsilon());
+
+      /** destructor*/
+      ~Fusion();
+
 
       //getters
       /**@return path of the coefficients*/
-      inline Path path() const {return path_;}
+      inline Path const& path() const {return path_;}
 
       /**@return Number of step of the algorithm*/
       inline int step() const {return step_;}
@@ -91,7 +105,7 @@ namespace HD
        * @param i step
        * @return the Pathstate object : the state of the path at the step i
        */
-      inline PathState const& path(int i) const {return path_.states(i);}
+      inline PathState path(int i) const {return path_.states(i);}
 
       /**
        * @param i index of the step
@@ -116,8 +130,13 @@ namespace HD
       /**@return the value of lambda */
       inline std::vector<STK::Real> lambda() const {return path_.lambda();}
 
+      /**@return residual sum of squares of each state of the path*/
+      inline std::vector<STK::Real> const& rss() const {return rss_;}
+
       /** @return the historic of add and drop variable*/
       inline std::vector< std::pair<std::vector<int>,std::vector<int> > > evolution() const {return path_.evolution();}
+      /** @return the add and drop variables of the step i+1*/
+      inline std::pair<std::vector<int> ,std::vector<int> > evolution(int i) const {return path_.evolution(i);}
 
       /** @return the intercept of the solution*/
       inline STK::Real mu() const {return mu_;}
@@ -133,6 +152,8 @@ namespace HD
 
       /** @return msg_error_*/
       inline std::string msg_error() const {return msg_error_;}
+      /** @return timings and counters of the lars algorithm, the computation of Z is counted in the initialization*/
+      inline Timings const& timings() const {return timings_;}
 
       /**
        * run the lars algorithm for solving the fusion problem on Z=X*L^-1 (L^-1 = lower triangular matrix of 1)
@@ -146,8 +167,13 @@ namespace HD
       void computeZ();
 
     private:
-      ///matrix of size n*p, a col = a covariate
+      /** no copy*/
+      Fusion(Fusion const&);
+      Fusion& operator=(Fusion const&);
+      ///matrix of size n*p, a col = a covariate. Empty if the object is constructed with a IDesign
       STK::CArrayXX X_;
+      ///design Z used by the lars algorithm
+      IDesign* p_Z_;
       ///vector size n, response
       STK::CVectorX y_;
       ///maximum number of steps for the lars algorithm
@@ -162,12 +188,16 @@ namespace HD
       int step_;
       ///solution path of the lars
       Path path_;
+      ///residual sum of squares of each state of the path
+      std::vector<STK::Real> rss_;
       ///ignored variables (due to correlation)
       STK::CArrayVector<bool> toIgnore_;
       /// if true, there is an intercept in the model
       bool intercept_;
       ///last error message
       std::string msg_error_;
+      ///timings and counters of the lars algorithm
+      Timings timings_;
 
   };
 }
@@ -0,0 +1,126 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file GramCache.cpp
+ *  @brief Code of methods associates to @c GramCache.
+ **/
+
+#include "../larsRmain.h"
+
+using namespace STK;
+using namespace std;
+
+namespace HD
+{
+/* default constructor: the cache is disabled*/
+GramCache::GramCache()
+                    : capacity_(0)
+                    , columns_(), slotVar_(), stamp_(), slotOf_()
+                    , clock_(0), nbHit_(0), nbMiss_(0)
+{}
+
+/*
+ * Constructor
+ * @param p number of variables (size of a column)
+ * @param maxCols maximal number of columns to store
+ * @param sizeMB memory cap in megabytes. If 0, the cache is disabled.
+ */
+GramCache::GramCache(int p, int maxCols, Real sizeMB)
+                    : capacity_(0)
+                    , columns_(), slotVar_(), stamp_(), slotOf_()
+                    , clock_(0), nbHit_(0), nbMiss_(0)
+{
+  if( (sizeMB <= 0) || (p <= 0) ) return;
+  Real nbCols = (sizeMB * 1024. * 1024.) / (p * sizeof(Real));
+  capacity_ = (nbCols < maxCols) ? (int) nbCols : maxCols;
+  if(capacity_ <= 0) { capacity_ = 0; return;}
+  //columns are allocated when they are inserted
+  columns_.resize(capacity_);
+  slotVar_.resize(capacity_, 0);
+  stamp_.resize(capacity_, 0);
+  slotOf_.resize(p+1, -1);
+}
+
+/*
+ * look for the column X'x_idx in the cache
+ * @param idx index of the variable
+ * @return a pointer on the column, NULL if it is not in the cache
+ */
+CVectorX const* GramCache::get(int idx)
+{
+  int slot = isEnabled() ? slotOf_[idx] : -1;
+  if(slot < 0)
+  {
+    nbMiss_++;
+    return 0;
+  }
+  nbHit_++;
+  stamp_[slot] = ++clock_;
+  return &columns_[slot];
+}
+
+/*
+ * store the column X'x_idx, replacing the least recently used one if the cache is full
+ * @param idx index of the variable
+ * @param column X'x_idx
+ */
+void GramCache::insert(int idx, CVectorX const& column)
+{
+  if(!isEnabled()) return;
+  int slot = slotOf_[idx];
+  if(slot < 0)
+  {
+    //empty slot or least recently used one
+    slot = 0;
+    for(int i = 0; i < capacity_; i++)
+    {
+      if(slotVar_[i] == 0) { slot = i; break;}
+      if(stamp_[i] < stamp_[slot]) { slot = i;}
+    }
+    if(slotVar_[slot] != 0) { slotOf_[slotVar_[slot]] = -1;}
+    slotVar_[slot] = idx;
+    slotOf_[idx] = slot;
+  }
+  columns_[slot] = column;
+  stamp_[slot] = ++clock_;
+}
+
+/*
+ * the column X'x_idx will be the first replaced
+ * @param idx index of the variable
+ */
+void GramCache::release(int idx)
+{
+  if(!isEnabled()) return;
+  int slot = slotOf_[idx];
+  if(slot >= 0) { stamp_[slot] = 0;}
+}
+
+}//end namespace HD
@@ -0,0 +1,112 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file GramCache.h
+ *  @brief In this file, we define the class @c GramCache.
+ **/
+
+
+#ifndef GRAMCACHE_H_
+#define GRAMCACHE_H_
+
+namespace HD
+{
+/**
+ * Bounded cache of columns of the Gram matrix X'X.
+ *
+ * When p is too large to store X'X, the lars algorithm only needs the columns
+ * X'x_j of the active variables. They are stored in at most capacity() slots,
+ * keyed by the index of the variable. When the cache is full, the least
+ * recently used column is replaced. Columns of variables dropped of the active set
+ * are released: they are kept but replaced first.
+ */
+  class GramCache
+  {
+    public:
+      /** default constructor: the cache is disabled*/
+      GramCache();
+      /**
+       * Constructor
+       * @param p number of variables (size of a column)
+       * @param maxCols maximal number of columns to store
+       * @param sizeMB memory cap in megabytes. If 0, the cache is disabled.
+       */
+      GramCache(int p, int maxCols, STK::Real sizeMB);
+
+      /** @return true if the cache can store at least one column*/
+      inline bool isEnabled() const {return capacity_ > 0;}
+      /** @return the maximal number of stored columns*/
+      inline int capacity() const {return capacity_;}
+      /** @return the number of times a column was found in the cache*/
+      inline int nbHit() const {return nbHit_;}
+      /** @return the number of times a column was not found in the cache*/
+      inline int nbMiss() const {return nbMiss_;}
+
+      /**
+       * look for the column X'x_idx in the cache
+       * @param idx index of the variable
+       * @return a pointer on the column, NULL if it is not in the cache
+       */
+      STK::CVectorX const* get(int idx);
+
+      /**
+       * store the column X'x_idx, replacing the least recently used one if the cache is full
+       * @param idx index of the variable
+       * @param column X'x_idx
+       */
+      void insert(int idx, STK::CVectorX const& column);
+
+      /**
+       * the column X'x_idx will be the first replaced
+       * @param idx index of the variable
+       */
+      void release(int idx);
+
+    private:
+      /// maximal number of stored columns
+      int capacity_;
+      /// stored columns
+      std::vector<STK::CVectorX> columns_;
+      /// index of the variable stored in each slot, 0 if the slot is empty
+      std::vector<int> slotVar_;
+      /// last use of each slot, 0 for a released slot
+      std::vector<long> stamp_;
+      /// slot of each variable, -1 if not in the cache
+      std::vector<int> slotOf_;
+      /// current time used for the stamps
+      long clock_;
+      /// number of hits
+      int nbHit_;
+      /// number of misses
+      int nbMiss_;
+  };
+}//end namespace HD
+
+#endif /* GRAMCACHE_H_ */
@@ -32,6 +32,7 @@
  *  @brief In this file, methods associates to @c Lars.
  **/
 
+#include <algorithm>
 #include "../larsRmain.h"
 
 using namespace STK;
@@ -49,9 +50,14 @@ Lars::Lars( CArrayXX const& X,CVectorX const& y, bool intercept)
           : n_(X.sizeRows())
           , p_(X.sizeCols())
           , maxSteps_(3*min(n_,p_))
-          , X_(X), y_(y)
+          , minLambda_(0.)
+          , maxNbActive_(p_)
+          , maxL1norm_(Arithmetic<Real>::max())
+          , p_ownDesign_(new ArrayDesign(X))
+          , p_X_(p_ownDesign_), y_(y)
           , muX_(Range(1,p_))
           , path_(maxSteps_)
+          , rss_()
           , isActive_(Range(1,p_), false)
           , toIgnore_(Range(1,p_), false)
           , nbActiveVariable_(0)
@@ -60,10 +66,20 @@ Lars::Lars( CArrayXX const& X,CVectorX const& y, bool intercept)
           , step_(0)
           , mu_()
           , eps_(Arithmetic<Real>::epsilon())
-          , Xi_(Range(1,n_),Range(1,1))
-          , qrX_(Xi_)
+          , Xa_(*p_X_, muX_, activeVariables_)
+          , qrX_()
+          , useCholesky_(false)
+          , cholR_()
+          , useReferenceSolve_(false)
+          , work_()
+          , timings_()
+          , v_(Range(1,0))
+          , nbValidV_(0)
           , c_(Range(1,0))
           , intercept_(intercept)
+          , useGram_(false)
+          , gram_()
+          , cache_()
           , msg_error_()
 { initialization();}
 
@@ -72,15 +88,22 @@ Lars::Lars( CArrayXX const& X,CVectorX const& y, bool intercept)
  * @param y response
  * @param maxStep number of maximum step to do
  * @param eps epsilon (for 0)
+ * @param useGram if true, X'X is computed once and the correlations are updated in the space of the variables
+ * @param cacheSize memory cap (in MB) of the cache of the columns X'x_j of the active variables, 0 for no cache.
  */
-Lars::Lars( CArrayXX const& X,CVectorX const& y, int maxSteps, bool intercept, Real eps)
+Lars::Lars( CArrayXX const& X,CVectorX const& y, int maxSteps, bool intercept, Real eps, bool useGram, Real cacheSize)
           : n_(X.sizeRows())
           , p_(X.sizeCols())
           , maxSteps_(maxSteps)
-          , X_(X)
+          , minLambda_(0.)
+          , maxNbActive_(p_)
+          , maxL1norm_(Arithmetic<Real>::max())
+          , p_ownDesign_(new ArrayDesign(X))
+          , p_X_(p_ownDesign_)
           , y_(y)
           , muX_(Range(1,p_))
           , path_(maxSteps_)
+          , rss_()
           , isActive_(Range(1,p_), false)
           , toIgnore_(Range(1,p_), false)
           , nbActiveVariable_(0)
@@ -89,13 +112,164 @@ Lars::Lars( CArrayXX const& X,CVectorX const& y, int maxSteps, bool intercept, R
           , step_(0)
           , mu_()
           , eps_(eps)
-          , Xi_(Range(1,n_), Range(1,1), 0.)
-          , qrX_(Xi_)
+          , Xa_(*p_X_, muX_, activeVariables_)
+          , qrX_()
+          , useCholesky_(false)
+          , cholR_()
+          , useReferenceSolve_(false)
+          , work_()
+          , timings_()
+          , v_(Range(1,0))
+          , nbValidV_(0)
           , c_( Range(1,0) )
           , intercept_(intercept)
+          , useGram_(useGram)
+          , gram_()
+          , cache_(p_, min(n_,p_), useGram ? 0. : cacheSize)
           , msg_error_()
 { initialization();}
 
+/*
+ * @param X design, a row=a individual
+ * @param y response
+ * @param maxStep number of maximum step to do
+ * @param eps epsilon (for 0)
+ * @param useGram if true, X'X is computed once and the correlations are updated in the space of the variables
+ * @param cacheSize memory cap (in MB) of the cache of the columns X'x_j of the active variables, 0 for no cache.
+ */
+Lars::Lars( IDesign const& X,CVectorX const& y, int maxSteps, bool intercept, Real eps, bool useGram, Real cacheSize)
+          : n_(X.sizeRows())
+          , p_(X.sizeCols())
+          , maxSteps_(maxSteps)
+          , minLambda_(0.)
+          , maxNbActive_(p_)
+          , maxL1norm_(Arithmetic<Real>::max())
+          , p_ownDesign_(0)
+          , p_X_(&X)
+          , y_(y)
+          , muX_(Range(1,p_))
+          , path_(maxSteps_)
+          , rss_()
+          , isActive_(Range(1,p_), false)
+          , toIgnore_(Range(1,p_), false)
+          , nbActiveVariable_(0)
+          , nbIgnoreVariable_(0)
+          , activeVariables_(Range(1,0))
+          , step_(0)
+          , mu_()
+          , eps_(eps)
+          , Xa_(*p_X_, muX_, activeVariables_)
+          , qrX_()
+          , useCholesky_(false)
+          , cholR_()
+          , useReferenceSolve_(false)
+          , work_()
+          , timings_()
+          , v_(Range(1,0))
+          , nbValidV_(0)
+          , c_( Range(1,0) )
+          , intercept_(intercept)
+          , useGram_(useGram)
+          , gram_()
+          , cache_(p_, min(n_,p_), useGram ? 0. : cacheSize)
+          , msg_error_()
+{ initialization();}
+
+/*
+ * @param X design, a row=a individual
+ * @param y response
+ * @param gram X'X, computed with X centered if intercept is true
+ * @param maxStep number of maximum step to do
+ * @param eps epsilon (for 0)
+ */
+Lars::Lars( IDesign const& X,CVectorX const& y, CArrayXX const& gram, int maxSteps, bool intercept, Real eps)
+          : n_(X.sizeRows())
+          , p_(X.sizeCols())
+          , maxSteps_(maxSteps)
+          , minLambda_(0.)
+          , maxNbActive_(p_)
+          , maxL1norm_(Arithmetic<Real>::max())
+          , p_ownDesign_(0)
+          , p_X_(&X)
+          , y_(y)
+          , muX_(Range(1,p_))
+          , path_(maxSteps_)
+          , rss_()
+          , isActive_(Range(1,p_), false)
+          , toIgnore_(Range(1,p_), false)
+          , nbActiveVariable_(0)
+          , nbIgnoreVariable_(0)
+          , activeVariables_(Range(1,0))
+          , step_(0)
+          , mu_()
+          , eps_(eps)
+          , Xa_(*p_X_, muX_, activeVariables_)
+          , qrX_()
+          , useCholesky_(false)
+          , cholR_()
+          , useReferenceSolve_(false)
+          , work_()
+          , timings_()
+          , v_(Range(1,0))
+          , nbValidV_(0)
+          , c_( Range(1,0) )
+          , intercept_(intercept)
+          , useGram_(true)
+          , gram_(gram)
+          , cache_()
+          , msg_error_()
+{ initialization();}
+
+/*
+ * @param X design, a row=a individual
+ * @param y response
+ * @param muX mean of each variable of X
+ * @param xty correlations X'*(y-mean(y)) computed with X centered
+ * @param maxStep number of maximum step to do
+ * @param eps epsilon (for 0)
+ */
+Lars::Lars( IDesign const& X,CVectorX const& y, CVectorX const& muX, CVectorX const& xty, int maxSteps, bool intercept, Real eps)
+          : n_(X.sizeRows())
+          , p_(X.sizeCols())
+          , maxSteps_(maxSteps)
+          , minLambda_(0.)
+          , maxNbActive_(p_)
+          , maxL1norm_(Arithmetic<Real>::max())
+          , p_ownDesign_(0)
+          , p_X_(&X)
+          , y_(y)
+          , muX_(muX)
+          , path_(maxSteps_)
+          , rss_()
+          , isActive_(Range(1,p_), false)
+          , toIgnore_(Range(1,p_), false)
+          , nbActiveVariable_(0)
+          , nbIgnoreVariable_(0)
+          , activeVariables_(Range(1,0))
+          , step_(0)
+          , mu_()
+          , eps_(eps)
+          , Xa_(*p_X_, muX_, activeVariables_)
+          , qrX_()
+          , useCholesky_(false)
+          , cholR_()
+          , useReferenceSolve_(false)
+          , work_()
+          , timings_()
+          , v_(Range(1,0))
+          , nbValidV_(0)
+          , c_(xty)
+          , intercept_(intercept)
+          , useGram_(false)
+          , gram_()
+          , cache_()
+          , msg_error_()
+{ initialization();}
+
+/* destructor*/
+Lars::~Lars()
+{ if(p_ownDesign_) delete p_ownDesign_;}
+
 /* initialization of algorithm
  */
 void Lars::initialization()
@@ -103,13 +277,15 @@ void Lars::initialization()
 #ifdef LARS_DEBUG
   stk_cerr << _T("Entering Lars::initialization")<<endl;
 #endif
+  Timings::Timer timer(timings_, Timings::initialization);
   if(intercept_)
   {
     //we center y
     mu_ = y_.mean();
     y_ -= mu_;
-    muX_ = meanByCol(X_);
-    X_  -= Const::VectorX(X_.rows()) * muX_.transpose();
+    //X is centered implicitly. The means are given with the correlations to the constructor
+    if(c_.size() != p_)
+    { for(int j = 1; j <= p_; j++) { muX_[j] = p_X_->colMean(j);}}
   }
   else
   {
@@ -118,27 +294,175 @@ void Lars::initialization()
   }
 #ifdef LARS_DEBUG
     print(y_,"y_","y centered");
-    print(X_,"X_","X_ centered");
     print(muX_,"muX_","muX computed");
 #endif
-  c_ = X_.transpose()*y_;
-  Xi_.reserveCols(min(n_,p_));
-  Xi_.shift(1,1);
+  //the first state has no active variable
+  rss_.reserve(maxSteps_+1);
+  rss_.push_back(y_.norm2());
+  if(c_.size() != p_) { centeredXtV(y_,c_);}
+  //X'X is computed once, each step then costs O(pk) instead of O(np). It is not computed
+  //when it is given to the constructor
+  if(useGram_ && gram_.sizeCols() != p_)
+  {
+    gram_.resize(Range(1,p_),Range(1,p_));
+    CVectorX xc(Range(1,n_)), gramCol(Range(1,p_));
+    for(int j = 1; j <= p_; j++)
+    {
+      centeredCol(j,xc);
+      centeredXtV(xc,gramCol);
+      gram_.col(j) = gramCol;
+    }
+  }
+  v_.resize(Range(1,min(n_,p_)));
+  v_ = 0.;
+  nbValidV_ = 0;
 
 #ifdef LARS_DEBUG
   stk_cerr << _T("Lars::initialization done")<<endl;
-  print(Xi_,"Xi_","initialization done");
   print(c_,"c_","initialization done");
   print(activeVariables_,"activeVariables_","initialization done");
 #endif
 }
 
 
+/*
+ * compute the centered column j of X
+ * @param j index of the variable
+ * @param xc x_j - muX_[j]
+ */
+void Lars::centeredCol(int j, CVectorX &xc) const
+{
+  xc.resize(Range(1,n_));
+  xc = -muX_[j];
+  p_X_->addCol(j,1.,xc);
+}
+
+/*
+ * compute the product of the centered X by a vector: X'*v - muX_*sum(v)
+ * @param v vector of size n
+ * @param a result of size p
+ */
+void Lars::centeredXtV(CVectorX const& v, CVectorX &a) const
+{
+  a.resize(Range(1,p_));
+  p_X_->transposeProduct(v,a);
+  Real sumV = v.sum();
+  for(int j = a.begin(); j < a.end(); j++)
+    a[j] -= muX_[j] * sumV;
+}
+
+/*
+ * compute a = X'*u = X'*Xi*w using the Gram matrix
+ * @param w Aa*Gi1 @see computeGi1
+ * @param a X' * equiangular vector
+ */
+void Lars::computeGramA(CVectorX const& w, CVectorX &a) const
+{
+  Timings::Timer timer(timings_, Timings::product);
+  a = 0.;
+  for(int k = 1; k <= nbActiveVariable_; k++)
+  {
+    int idx = activeVariables_[k];
+    for(int j = a.begin(); j < a.end(); j++)
+      a[j] += gram_(j,idx) * w[k];
+  }
+}
+
+/*
+ * compute a = X'*u = X'*Xi*w using the cached columns of X'X
+ * @param w Aa*Gi1 @see computeGi1
+ * @param u work vector of size n
+ * @param a X' * equiangular vector
+ */
+void Lars::computeCachedA(CVectorX const& w, CVectorX &u, CVectorX &a)
+{
+  Timings::Timer timer(timings_, Timings::product);
+  a = 0.;
+  u = 0.;
+  Real shift = 0.;
+  bool allCached = true;
+  for(int k = 1; k <= nbActiveVariable_; k++)
+  {
+    int idx = activeVariables_[k];
+    CVectorX const* gramCol = cache_.get(idx);
+    if(gramCol)
+    {
+      for(int j = a.begin(); j < a.end(); j++)
+        a[j] += (*gramCol)[j] * w[k];
+    }
+    else
+    {
+      //column evicted: u contains the part of the equiangular vector not in the cache
+      p_X_->addCol(idx,w[k],u);
+      shift += muX_[idx] * w[k];
+      allCached = false;
+    }
+  }
+  if(!allCached)
+  {
+    u -= shift;
+    centeredXtV(u,work_.aMissing_);
+    a += work_.aMissing_;
+  }
+}
+
+/*
+ * put the column X'x_idxVar in the cache if it is not there
+ * @param idxVar index of the added variable
+ */
+void Lars::cacheGramCol(int idxVar)
+{
+  Timings::Timer timer(timings_, Timings::product);
+  if(!cache_.isEnabled() || cache_.get(idxVar)) return;
+  centeredCol(idxVar,work_.xc_);
+  centeredXtV(work_.xc_,work_.gramCol_);
+  cache_.insert(idxVar, work_.gramCol_);
+}
+
+/*
+ * add the variable idxVar to the Cholesky factor
+ * @param idxVar index of the variable to add
+ * @return false if the variable is colinear with the active variables
+ */
+bool Lars::addCholesky(int idxVar)
+{
+  //cross products of the new variable with the active variables
+  CVectorX& g = work_.g_;
+  Real d;
+  if(useGram_)
+  {
+    for(int k = 1; k <= nbActiveVariable_; k++)
+      g[k] = gram_(activeVariables_[k],idxVar);
+    d = gram_(idxVar,idxVar);
+  }
+  else
+  {
+    //a single product Xa'x_new on the active variables
+    CVectorX& xc = work_.xc_;
+    centeredCol(idxVar,xc);
+    Xa_.transposeProduct(xc,g);
+    d = xc.norm2();
+  }
+  return cholR_.pushBackCol(g, d, eps_);
+}
+
+/*
+ * compute the equiangular vector u = Xi*w
+ * @param w Aa*Gi1 @see computeGi1
+ * @param u equiangular vector
+ */
+void Lars::computeEquiangular(CVectorX const& w, CVectorX &u) const
+{
+  Timings::Timer timer(timings_, Timings::product);
+  Xa_.product(w,u);
+}
+
 /*
  * compute Cmax the maximum correlation
  */
 Real Lars::computeCmax()
 {
+  Timings::Timer timer(timings_, Timings::addSet);
   Real Cmax = 0.;
   for(int i = isActive_.begin(); i < isActive_.end(); i++)
   { if(!isActive_[i]) { Cmax = std::max(Cmax, std::abs(c_[i]));}}
@@ -152,6 +476,7 @@ Real Lars::computeCmax()
  */
 void Lars::computeAddSet(Real Cmax, vector<int>& newId ) const
 {
+  Timings::Timer timer(timings_, Timings::addSet);
   for(int i = isActive_.begin(); i < isActive_.end(); i++)
   {
     if(!isActive_[i])//update with only variable non active
@@ -165,7 +490,7 @@ void Lars::computeAddSet(Real Cmax, vector<int>& newId ) const
 
 
 /*
- * update the QR decomposition of Xi
+ * update the QR decomposition of Xi or the Cholesky factor of Xi'Xi
  * @param idxVar index of active variable to add
  * @param signC sign of correlation of active variable
  * @param action a pair with first element is a bool (true for addcase, false for dropcase) and second the idx variable to drop/add
@@ -175,34 +500,36 @@ void Lars::updateR(int idxVar,VectorXi &signC, pair<bool,vector<int> > &action)
 #ifdef LARS_DEBUG
   stk_cerr << _T("Entering Lars::updateR")<<endl;
 #endif
-  //update Xi_
-  Xi_.pushBackCols(1);
-  Xi_.shift(1,1); // in case
-  Xi_.col(Xi_.lastIdxCols()) = X_.col(idxVar);
-  //update the QR decomposition
-  qrX_.pushBackCol(Xi_.col(Xi_.lastIdxCols()));
+  bool isColinear;
+  {
+    Timings::Timer timer(timings_, Timings::factorization);
+    if(useCholesky_)
+    {
+      //update the Cholesky factor, the check of colinearity is done by addCholesky
+      isColinear = !addCholesky(idxVar);
+    }
+    else
+    {
+      //update the QR decomposition with the centered column, which is not kept.
+      //The variable is not added if it is colinear with an other
+      centeredCol(idxVar,work_.xc_);
+      isColinear = !qrX_.pushBackCol(work_.xc_, eps_);
+    }
+  }
 
 #ifdef VERBOSE
     cout<<"Step "<<step_<<" : Variable "<< idxVar<<" added"<<endl;
-//      cout<<std::abs(qrX_.R()( min(n_,nbActiveVariable_+1), nbActiveVariable_+1) )<<std::endl;
 #endif
 
-  //check if the variable added is not colinear with an other
-  if( std::abs(qrX_.R()( min(n_,nbActiveVariable_+1), nbActiveVariable_+1) ) < eps_ )
+  if(isColinear)
   {
-#ifdef LARS_DEBUG
-  stk_cerr << _T("Lars::updateR popBackCol")<<endl;
-#endif
-    //we cancel the add of the variable in the qr decomposition
-    qrX_.popBackCols();
 #ifdef LARS_DEBUG
       cout<<"Step "<<step_<<" : Variable "<< idxVar<<" dropped (colinearity)"<<endl;
 #endif
     //toIgnore_[idxVar+1]=true;//the variable is add to the ignore set
     toIgnore_[idxVar]=true;//the variable is add to the ignore set
     nbIgnoreVariable_++;
-    Xi_.popBackCols(1);
-    Xi_.shift(1,1); // in case
+    timings_.countIgnore();
 #ifdef LARS_DEBUG
   stk_cerr << _T("Lars::updateR popBack done")<<endl;
 #endif
@@ -221,10 +548,12 @@ void Lars::updateR(int idxVar,VectorXi &signC, pair<bool,vector<int> > &action)
     activeVariables_.shift(1); // in case
 
     nbActiveVariable_++;
+    timings_.countAdd();
     isActive_[idxVar] = true;
     //compute signC
     signC.pushBack(1);
     signC[nbActiveVariable_] = ( c_[idxVar] > 0 ) ? 1 : -1;
+    cacheGramCol(idxVar);
 #ifdef LARS_DEBUG
   stk_cerr << _T("Lars::updateR pushBack done")<<endl;
 #endif
@@ -241,31 +570,92 @@ void Lars::updateR(int idxVar,VectorXi &signC, pair<bool,vector<int> > &action)
  * @param Gi1 for stock inv(Xi'*Xi)*1
  * @param signC sign of correlation of active variable
  */
-void Lars::computeGi1(CVectorX &Gi1, VectorXi const& signC) const
+void Lars::computeGi1(CVectorX &Gi1, VectorXi const& signC)
+{
+  Timings::Timer timer(timings_, Timings::gi1);
+  if(useReferenceSolve_)
+  {
+    CVectorX Gi1Ref;
+    computeGi1Reference(Gi1Ref,signC);
+    for(int j = 1; j <= nbActiveVariable_; j++)
+      Gi1[j] = Gi1Ref[j];
+    return;
+  }
+  //inv(Xi'*Xi)*1 = signC*inv(R)*inv(R')*signC, R being the R of the QR decomposition of Xi or the Cholesky factor
+  //resolve R'*v=signC, the first nbValidV_ elements of v_ are unchanged since the last step
+  for(int j = nbValidV_+1; j <= nbActiveVariable_; j++)
+  {
+    Real sum = signC[j];
+    for(int k = 1; k < j; k++)
+      sum -= factorR(k,j)*v_[k];
+    v_[j] = sum/factorR(j,j);
+  }
+  nbValidV_ = nbActiveVariable_;
+  //resolve R*signC*Gi1=v
+  for(int j = nbActiveVariable_; j > 0; j--)
+  {
+    Real sum = v_[j];
+    for(int k = j+1; k <= nbActiveVariable_; k++)
+      sum -= signC[k] * factorR(j,k) * Gi1[k];
+    Gi1[j] = sum/(signC[j] * factorR(j,j));
+  }
+}
+
+/*
+ * @param Gi1 inv(Xi'*Xi)*1 @see computeGi1
+ * @return Aa = 1/sqrt(1'*inv(Xi'*Xi)*1)
+ */
+Real Lars::computeAa(CVectorX const& Gi1) const
+{
+  Real sum = 0.;
+  for(int k = 1; k <= nbActiveVariable_; k++)
+    sum += Gi1[k];
+  return 1/sqrt(sum);
+}
+
+/*
+ * compute w = Aa*Gi1 with the signs of the correlations
+ * @param Gi1 inv(Xi'*Xi)*1 @see computeGi1
+ * @param signC sign of correlation of active variable
+ * @param Aa @see computeAa
+ * @param w result, only the nbActiveVariable_ first elements are computed
+ */
+void Lars::computeW(CVectorX const& Gi1, VectorXi const& signC, Real Aa, CVectorX &w) const
+{
+  for(int k = 1; k <= nbActiveVariable_; k++)
+    w[k] = Gi1[k] * signC[k] * Aa;
+}
+
+/*
+ * compute inv(Xi'*Xi)*1 from qr decomposition by solving one triangular system
+ * for each active variable
+ * @param Gi1 for stock inv(Xi'*Xi)*1
+ * @param signC sign of correlation of active variable
+ */
+void Lars::computeGi1Reference(CVectorX &Gi1, VectorXi const& signC) const
 {
   CVectorX v(Range(1,nbActiveVariable_));
   Gi1.resize(Range(1,nbActiveVariable_));
   Gi1=0;
-//    signC.shift(1); // in case
   for(int i=1; i<=nbActiveVariable_; i++)
   {
     //resolve R'*v=signC(i)*e_i
     v=0.;
     v[i]=signC[i];
-    v[1] /= qrX_.R()(i,i);
+    v[1] /= factorR(i,i);
     for(int j=2; j<=nbActiveVariable_; j++)
     {
       for(int k=1; k<=(j-1); k++)
-        v[j] -= qrX_.R()(k,j)*v[k];
-      v[j]/=qrX_.R()(j,j);
+        v[j] -= factorR(k,j)*v[k];
+      v[j]/=factorR(j,j);
     }
     //resolve R*signC*z=v
-    v[nbActiveVariable_] *= signC[nbActiveVariable_]/qrX_.R()(nbActiveVariable_,nbActiveVariable_);
+    v[nbActiveVariable_] *= signC[nbActiveVariable_]/factorR(nbActiveVariable_,nbActiveVariable_);
     for(int j=nbActiveVariable_-1; j>0; j--)
     {
       for(int k=j+1; k <= nbActiveVariable_; k++)
-        v[j] -= signC[k] * qrX_.R()(j,k) * v[k];
-      v[j] /= signC[j] * qrX_.R()(j,j);
+        v[j] -= signC[k] * factorR(j,k) * v[k];
+      v[j] /= signC[j] * factorR(j,j);
     }
     Gi1+=v;
   }
@@ -274,26 +664,91 @@ void Lars::computeGi1(CVectorX &Gi1, VectorXi const& signC) const
 /*
  * Compute gammahat for the update of coefficient in add case
  * @param Aa norm of the inverse of G
- * @param a X' * equiangular vector
+ * @param u equiangular vector
+ * @param a X' * equiangular vector (computed if computeA is true)
  * @param Cmax correlation max
+ * @param computeA if true, compute a from X and u
  * @return gammaHat a real
  */
-Real Lars::computeGamHat(Real const& Aa, CVectorX const& a, Real Cmax) const
+Real Lars::computeGamHat(Real const& Aa, CVectorX const& u, CVectorX &a, Real Cmax, bool computeA)
 {
-  Real gamHat(Cmax/Aa), gam(0);
-  for(int i=isActive_.begin(); i<isActive_.end(); i++)
+  Timings::Timer timer(timings_, Timings::gamma);
+  int nbBlock = (p_ + blockSize_ - 1)/blockSize_;
+  vector<Real>& blockGamHat = work_.blockGamHat_;
+  blockGamHat.assign(nbBlock, Cmax/Aa);
+  //X is centered implicitly: a_j = x_j'*u - muX_[j]*sum(u)
+  Real sumU = computeA ? u.sum() : 0.;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(nbBlock > 3)
+#endif
+  for(int b = 0; b < nbBlock; b++)
   {
-    //only for the non active variable and non ignored variable
-    if(!isActive_[i] && !toIgnore_[i])
+    int first = isActive_.begin() + b*blockSize_, last = min(isActive_.end(), first + blockSize_);
+    Real gamHat(blockGamHat[b]), gam(0);
+    for(int i = first; i < last; i++)
     {
-      //gamma is the min only on the positive value of gam1 and gam2
-      if(Aa!=a[i]) { if( (gam = (Cmax-c_[i])/(Aa-a[i]) ) > eps_ ) {gamHat=min(gamHat,gam);}}
-      if(Aa!=-a[i]){ if( (gam = (Cmax+c_[i])/(Aa+a[i]) ) > eps_ ) {gamHat=min(gamHat,gam);}}
+      if(computeA) { a[i] = p_X_->dot(i,u) - muX_[i] * sumU;}
+      //only for the non active variable and non ignored variable
+      if(!isActive_[i] && !toIgnore_[i])
+      {
+        //gamma is the min only on the positive value of gam1 and gam2
+        if(Aa!=a[i]) { if( (gam = (Cmax-c_[i])/(Aa-a[i]) ) > eps_ ) {gamHat=min(gamHat,gam);}}
+        if(Aa!=-a[i]){ if( (gam = (Cmax+c_[i])/(Aa+a[i]) ) > eps_ ) {gamHat=min(gamHat,gam);}}
+      }
     }
+    blockGamHat[b] = gamHat;
   }
+  Real gamHat(Cmax/Aa);
+  for(int b = 0; b < nbBlock; b++) { gamHat = min(gamHat, blockGamHat[b]);}
   return gamHat;
 }
 
+/*
+ * update the correlations and compute the correlation max and the add set of the next step
+ * @param a X' * equiangular vector
+ * @param gamma step of the update
+ * @param newId a vector containing the index of variable to potentially add at the next step
+ * @return the correlation max of the next step
+ */
+Real Lars::updateCorrelation(CVectorX const& a, Real gamma, vector<int>& newId)
+{
+  Timings::Timer timer(timings_, Timings::correlation);
+  int nbBlock = (p_ + blockSize_ - 1)/blockSize_;
+  vector<Real>& blockCmax = work_.blockCmax_;
+  vector< vector<int> >& blockId = work_.blockId_;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(nbBlock > 3)
+#endif
+  for(int b = 0; b < nbBlock; b++)
+  {
+    int first = isActive_.begin() + b*blockSize_, last = min(isActive_.end(), first + blockSize_);
+    Real Cmax = 0.;
+    blockId[b].clear();
+    for(int i = first; i < last; i++)
+    {
+      c_[i] -= a[i] * gamma;
+      if(!isActive_[i])
+      {
+        Real absC = std::abs(c_[i]);
+        Cmax = std::max(Cmax, absC);
+        //the final Cmax is greater than the current one: keep all the potential candidates
+        if( !toIgnore_[i] & (absC >= Cmax-eps_) ) { blockId[b].push_back(i);}
+      }
+    }
+    blockCmax[b] = Cmax;
+  }
+  //reduction in the order of the blocks: newId is sorted as with computeAddSet
+  Real Cmax = 0.;
+  for(int b = 0; b < nbBlock; b++) { Cmax = std::max(Cmax, blockCmax[b]);}
+  newId.resize(0);
+  for(int b = 0; b < nbBlock; b++)
+  {
+    for(vector<int>::const_iterator it = blockId[b].begin(); it != blockId[b].end(); it++)
+    { if(std::abs(c_[*it]) >= Cmax-eps_) { newId.push_back(*it);}}
+  }
+  return Cmax;
+}
+
 /*
  * Compute gammaTilde for the update of coefficient in drop case
  * @param w Aa*Gi1 @see computeGi1
@@ -302,9 +757,10 @@ Real Lars::computeGamHat(Real const& Aa, CVectorX const& a, Real Cmax) const
  */
 Real Lars::computeGamTilde(CVectorX const& w,vector<int> &idxMin) const
 {
+  Timings::Timer timer(timings_, Timings::gamma);
   Real gamTilde(std::numeric_limits<Real>::max()),gam(0);
   idxMin.erase(idxMin.begin(),idxMin.end());
-  for(int i=1; i <= path_.lastState().size(); i++)
+  for(int i=1; i <= path_.size(path_.size()-1); i++)
   {
     if(w[i]) gam = -path_.lastVarCoeff(i)/w[i];
     //we search the minimum only on positive value
@@ -329,12 +785,13 @@ Real Lars::computeGamTilde(CVectorX const& w,vector<int> &idxMin) const
  * @param isAddCase true if we add a variable
  * @param dropId id top potentially drop
  */
-void Lars::updateBeta(Real gamma, CVectorX const& w, pair<bool,vector<int> > action, bool isAddCase, vector<int> dropId)
+void Lars::updateBeta(Real gamma, CVectorX const& w, pair<bool,vector<int> > const& action, bool isAddCase, vector<int> const& dropId)
 {
 #ifdef LARS_DEBUG
   stk_cerr << _T("Entering Lars::updateBeta")<<endl;
   print(w,"w", "updateBeta");
 #endif
+  Timings::Timer timer(timings_, Timings::path);
   if( (action.first) && (isAddCase) )
   {
     //add situation
@@ -345,7 +802,8 @@ void Lars::updateBeta(Real gamma, CVectorX const& w, pair<bool,vector<int> > act
     if( (action.first) && (!isAddCase) )
     {
       //add situation with a drop
-      vector<int> drop(dropId.size());
+      vector<int>& drop = work_.drop_;
+      drop.resize(dropId.size());
       for(int i = 0; i < (int) dropId.size(); i++)
       { drop[i] = activeVariables_[dropId[i]];}
       path_.addWithDropCaseUpdate(gamma,w,action.second,drop,dropId);
@@ -359,7 +817,8 @@ void Lars::updateBeta(Real gamma, CVectorX const& w, pair<bool,vector<int> > act
       }
       else
       {
-        vector<int> drop(dropId.size());
+        vector<int>& drop = work_.drop_;
+        drop.resize(dropId.size());
         for(int i = 0; i < (int) dropId.size(); i++)
         {  drop[i] = activeVariables_[dropId[i]];}
         //drop step after a drop step
@@ -380,15 +839,14 @@ void Lars::updateBeta(Real gamma, CVectorX const& w, pair<bool,vector<int> > act
  */
 void Lars::dropStep(vector<int> const& idxVar, VectorXi &signC)
 {
+  Timings::Timer timer(timings_, Timings::factorization);
+  timings_.countDrop(idxVar.size());
 #ifdef VERBOSE
     for(int i = 0; i < (int) idxVar.size(); i++)
       cout<<"Step "<<step_+1<<" : Variable "<< activeVariables_[idxVar[i]]<<" dropped"<<endl;
 #endif
 #ifdef LARS_DEBUG
   stk_cerr << _T("Entering Lars::dropStep")<<endl;
-  print(qrX_.R(),"qrX_.R()", "dropStep");
-  print(qrX_.Q(),"qrX_.Q()", "dropStep");
-  print(Xi_,"Xi_", "dropStep");
   print(signC,"signC", "dropStep");
   print(activeVariables_,"activeVariables_", "dropStep");
 #endif
@@ -399,18 +857,13 @@ void Lars::dropStep(vector<int> const& idxVar, VectorXi &signC)
 #ifdef LARS_DEBUG
   stk_cerr << _T("idxVar[i]=")<<idxVar[i]<<endl;
   stk_cerr << _T("qrX_.eraseCol(")<< idxVar[i] << _T(")") <<endl;
-  if (idxVar[i] < qrX_.R().beginCols())
-  { stk_cerr << _T("idxVar[i] < qrX_.R().beginCols()") <<endl;}
-  if (qrX_.R().lastIdxCols() < idxVar[i])
-  { stk_cerr << _T("qrX_.R().lastIdxCols() < idxVar[i]") <<endl;}
-#endif
-  //downdate R
-    qrX_.eraseCol(idxVar[i]);
-    //downdate Xi_
-#ifdef LARS_DEBUG
-  stk_cerr << _T("Xi_.eraseCols(")<< idxVar[i] << _T(")") <<endl;
+  if ( (idxVar[i] < 1) || (nbActiveVariable_ + (int) idxVar.size() < idxVar[i]) )
+  { stk_cerr << _T("idxVar[i] out of the active set") <<endl;}
 #endif
-    Xi_.eraseCols(idxVar[i]);
+    if(useCholesky_) { cholR_.eraseCol(idxVar[i]);}
+    else { qrX_.eraseCol(idxVar[i]);}
+    //the columns of R after idxVar[i] are modified: the forward solve is valid until idxVar[i]-1
+    nbValidV_ = min(nbValidV_, idxVar[i]-1);
 #ifdef LARS_DEBUG
   stk_cerr << _T("signC.erase(")<< idxVar[i] << _T(")") <<endl;
 #endif
@@ -419,6 +872,7 @@ void Lars::dropStep(vector<int> const& idxVar, VectorXi &signC)
   stk_cerr << _T("activeVariables_[idxVar[i]]=")<<activeVariables_[idxVar[i]]<<endl;
 #endif
     isActive_[activeVariables_[idxVar[i]]] = false;
+    cache_.release(activeVariables_[idxVar[i]]);
 #ifdef LARS_DEBUG
   stk_cerr << _T("activeVariables_.erase(")<< idxVar[i] << _T(")") <<endl;
 #endif
@@ -432,7 +886,8 @@ void Lars::dropStep(vector<int> const& idxVar, VectorXi &signC)
 /*
  * first step
  * @param Cmax correlation max
- * @param newId vector of index of active variable to add
+ * @param nextCmax correlation max of the second step
+ * @param newId vector of index of active variable to add (at the end: add set of the second step)
  * @param signC sign of correlation of active variable
  * @param action a pair with first element is a bool (true for addcase, false for dropcase) and second the idx variable to drop/add
  * @param Aa norm of the inverse of G
@@ -443,7 +898,7 @@ void Lars::dropStep(vector<int> const& idxVar, VectorXi &signC)
  * @param gam the step for update coefficients
  * @return
  */
-bool Lars::firstStep( Real &Cmax, vector<int> &newId
+bool Lars::firstStep( Real &Cmax, Real &nextCmax, vector<int> &newId
                     , VectorXi &signC
                     , pair<bool, vector<int> > &action
                     , Real &Aa
@@ -507,30 +962,45 @@ bool Lars::firstStep( Real &Cmax, vector<int> &newId
   stk_cerr << _T("computeGi1 done")<<endl;
 #endif
   //compute Aa
-  Aa = 1/sqrt(Gi1.sum());
+  Aa = computeAa(Gi1);
   //compute w
-  w = Gi1 * signC * Aa;
-  //compute equiangular vector
-  u = Xi_ * w;
+  computeW(Gi1,signC,Aa,w);
+  //computation of a = X'*u with u the equiangular vector. Without gram matrix
+  //or cache, a is computed with gamma hat
+  if(useGram_) { computeGramA(w,a);}
+  else if(cache_.isEnabled()) { computeCachedA(w,u,a);}
+  else
+  {
+    computeEquiangular(w,u);
+    //the variables are not stored: a is computed with a single product
+    if(!p_X_->hasCheapColumns())
+    {
+      Timings::Timer timer(timings_, Timings::product);
+      centeredXtV(u,a);
+    }
+  }
+  bool computeA = !useGram_ && !cache_.isEnabled() && p_X_->hasCheapColumns();
   //computation of gamma hat
   //if the number of active variable is equal to the max number authorized, we don't search a new index
   if( nbActiveVariable_ == min(n_-1,p_-nbIgnoreVariable_) )
-  {  gam=Cmax/Aa;}
-  else
   {
-    //computation of a
-    a = X_.transpose() * u;
-    //computation of gamma hat
-    gam = computeGamHat(Aa,a,Cmax);
+    if(computeA)
+    {
+      Timings::Timer timer(timings_, Timings::product);
+      centeredXtV(u,a);
+    }
+    gam=Cmax/Aa;
   }
+  else
+  {  gam = computeGamHat(Aa,u,a,Cmax,computeA);}
   //update beta
-  vector<int> vide;
-  updateBeta(gam,w,action,true,vide);
+  addRss(gam,w);
+  updateBeta(gam,w,action,true,work_.noDrop_);
 #ifdef LARS_DEBUG
   stk_cerr << _T("updateBeta done")<<endl;
 #endif
-  //update of c
-  c_ -= (X_.transpose() * u) * gam;
+  //update of c, correlation max and add set of the next step
+  nextCmax = updateCorrelation(a,gam,newId);
 #ifdef LARS_DEBUG
   stk_cerr << _T("Lars::firstStep done. Return true")<<endl;
 #endif
@@ -546,13 +1016,24 @@ void Lars::firstUpdateR(int idxVar, VectorXi &signC, pair<bool,vector<int> > &ac
 #ifdef LARS_DEBUG
   stk_cerr << _T("Entering Lars::firstUpdateR")<<endl;
 #endif
-  //create Xi_ and qrXi_
-  Xi_.col(Xi_.lastIdxCols()) = X_.col(idxVar);
-  Xi_.shift(1,1); // in case
-  qrX_.setData(Xi_);
-  qrX_.run();
+  //the Cholesky factor is updated in the same way at each step
+  if(useCholesky_)
+  {
+    updateR(idxVar,signC,action);
+    return;
+  }
+  //create qrX_ from the first centered column
+  bool isColinear;
+  {
+    Timings::Timer timer(timings_, Timings::factorization);
+    centeredCol(idxVar,work_.xc_);
+    qrX_.clear();
+    isColinear = !qrX_.pushBackCol(work_.xc_, eps_);
+  }
+  //R is computed from scratch
+  nbValidV_ = 0;
 #ifdef LARS_DEBUG
-  stk_cerr << _T("qrX_.run() done.")<<endl;
+  stk_cerr << _T("qrX_.pushBackCol done.")<<endl;
 #endif
 
 #ifdef VERBOSE
@@ -560,22 +1041,17 @@ void Lars::firstUpdateR(int idxVar, VectorXi &signC, pair<bool,vector<int> > &ac
 #endif
 
   //check if the variable added is not colinear with an other
-  if( std::abs(qrX_.R()( min(n_,nbActiveVariable_+1), nbActiveVariable_+1) ) < eps_ )
+  if(isColinear)
   {
-#ifdef LARS_DEBUG
-  stk_cerr << _T("Entering popBackCols")<<endl;
-#endif
-    qrX_.popBackCols();
 #ifdef VERBOSE
       cout<<"Step 1 : Variable "<< idxVar<<" dropped (colinearity)"<<endl;
 #endif
 
     toIgnore_[idxVar+1] = true;//the variable is add to the ignore set
     nbIgnoreVariable_++;
-    Xi_.popBackCols(1);
-    Xi_.shift(1,1); // in case
+    timings_.countIgnore();
 #ifdef LARS_DEBUG
-  stk_cerr << _T("popBackCols done.")<<endl;
+  stk_cerr << _T("colinear variable ignored.")<<endl;
 #endif
   }
   else
@@ -584,6 +1060,7 @@ void Lars::firstUpdateR(int idxVar, VectorXi &signC, pair<bool,vector<int> > &ac
   stk_cerr << _T("Entering pushBack")<<endl;
 #endif
     nbActiveVariable_++;
+    timings_.countAdd();
     //Add the idx to the active set
     activeVariables_.pushBack(1);
     activeVariables_.shift(1); // in case
@@ -595,6 +1072,7 @@ void Lars::firstUpdateR(int idxVar, VectorXi &signC, pair<bool,vector<int> > &ac
     signC.pushBack(1);
     signC.shift(1); // in case
     signC.back() = ( c_[idxVar] > 0 ) ? 1 : -1;
+    cacheGramCol(idxVar);
 
     action.first = true;
     action.second.push_back(idxVar);
@@ -604,6 +1082,33 @@ void Lars::firstUpdateR(int idxVar, VectorXi &signC, pair<bool,vector<int> > &ac
   }
 }
 
+/*
+ * add the residual sum of squares of the next state
+ * @param gamma step of the update
+ * @param w Aa*Gi1
+ */
+void Lars::addRss(Real gamma, CVectorX const& w)
+{
+  Timings::Timer timer(timings_, Timings::path);
+  //u'r with the correlations of the active variables. In a drop step, activeVariables_ still contains
+  //the dropped variables
+  Real ur = 0.;
+  for(int k = activeVariables_.begin(); k < activeVariables_.end(); k++)
+    ur += w[k] * c_[activeVariables_[k]];
+  rss_.push_back(std::max(Real(0.), rss_.back() - 2. * gamma * ur + gamma * gamma));
+}
+
+/*
+ * @param Cmax lambda at the beginning of the last step
+ * @return true if one of the early stopping criteria (minLambda_, maxNbActive_, maxL1norm_) is reached
+ */
+bool Lars::isStopReached(Real Cmax) const
+{
+  //the lambda of the last state is lower than Cmax: we stop when the lambda recorded for the last step is
+  //below minLambda_, so every lambda >= minLambda_ lies between two states of the path
+  return (Cmax <= minLambda_) || (nbActiveVariable_ >= maxNbActive_) || (path_.l1norm(path_.size()-1) >= maxL1norm_);
+}
+
 /* run lars algorithm*/
 void Lars::run()
 {
@@ -616,150 +1121,202 @@ void Lars::run()
 #ifdef LARS_DEBUG
   stk_cerr << _T("Entering Lars::run")<<endl;
 #endif
-  //initialization();
-  bool isAddCase(true), continuer;
-  vector<int> dropId;
-  Real Aa(0),gam(0),gammaTilde(0),Cmax(0);
+  if (!start()) return;
+  //we stop, if we reach maxStep or if there is no more variable to add
+  while(beginStep()) { endStep();}
+#ifdef LARS_DEBUG
+  stk_cerr << _T("Lars::run while terminated")<<endl;
+  stk_cerr<<endl<<"Algorithm finished"<<endl;
+  stk_cerr<<"Number of steps: "<<step_<<endl;
+  stk_cerr<<"Number of active variables: "<<nbActiveVariable_<<endl;
+#endif
+
+#ifdef VERBOSE
+  Real t1 = Chrono::elapsed();
+  cout<<endl<<"Algorithm finished in "<<t1<<"s"<<endl;
+  cout<<"Number of steps: "<<step_<<endl;
+  cout<<"Number of active variables: "<<nbActiveVariable_<<endl;
+#endif
+#ifdef LARS_DEBUG
+  stk_cerr << _T("Lars::run done")<<endl;
+#endif
+}
 
-  CVectorX Gi1(Range(1,1));
-  CVectorX w(Range(1,0));
-  VectorXi signC(Range(1,0));
-  CVectorX a( Range(1,p_), 0), u( Range(1,n_), 0);
-  pair<bool,vector<int> > action;
+/*
+ * initialize the state of the algorithm and run the first step
+ * @return false if the algorithm stops at the first step
+ */
+bool Lars::start()
+{
+  isAddCase_ = true;
+  dropId_.clear();
+  Aa_ = 0; gam_ = 0; Cmax_ = 0; nextCmax_ = 0;
 
-  vector<int> newId;
-  newId.reserve(p_);
+  //all the buffers of the steps are allocated here, for the maximal number of active variables:
+  //the steps do not allocate memory, apart from the growth of the arrays of the path (see reservePath)
+  //and the first fill of each column of the cache
+  int kMax = min(n_,p_);
+  Gi1_.resize(Range(1,kMax)); Gi1_ = 0.;
+  w_.resize(Range(1,kMax)); w_ = 0.;
+  signC_.resize(Range(1,0));
+  signC_.reserveCols(kMax);
+  activeVariables_.reserveCols(kMax);
+  a_.resize(Range(1,p_)); a_ = 0.;
+  u_.resize(Range(1,n_)); u_ = 0.;
+  action_ = pair<bool,vector<int> >();
+  action_.second.reserve(kMax);
+  dropId_.reserve(kMax);
+  rss_.reserve(maxSteps_+2);
+  work_.reserve(n_, p_, kMax, blockSize_, cache_.isEnabled());
 
-  //Gi1.reserveCols(min(n_-1,p_));
-  //w.reserveCols(min(n_-1,p_));
-  signC.reserveCols(min(n_-1,p_));
+  newId_.clear();
+  newId_.reserve(p_);
 
-  continuer=firstStep(Cmax,newId,signC,action,Aa,Gi1,w,u,a,gam);
-  if (!continuer) return;
-  //we stop, if we reach maxStep or if there is no more variable to add
-  Real oldCmax;
-  while( (step_< maxSteps_) && ( nbActiveVariable_ < min( n_-1, (p_-nbIgnoreVariable_) ) ) )
+  //the active set is factorized with the QR decomposition of Xi (O(nk) memory, at most the size of X)
+  //or the Cholesky factor of Xi'Xi (O(k^2) memory). The factor is reserved for the number of active
+  //variables allowed by the stopping criteria, and grows if ties make it larger
+  int kFactor = min(kMax, min(maxNbActive_, maxSteps_) + 1);
+  if(useCholesky_) { cholR_.reserve(kFactor);}
+  else { qrX_.reserve(n_, kFactor);}
+
+  return firstStep(Cmax_,nextCmax_,newId_,signC_,action_,Aa_,Gi1_,w_,u_,a_,gam_);
+}
+
+/*
+ * begin a step: update of the active set and computation of the equiangular vector
+ * @return false if the algorithm stops
+ */
+bool Lars::beginStep()
+{
+  if( nbActiveVariable_ >= min( n_-1, (p_-nbIgnoreVariable_) ) )
+    return false;
+  //truncated path: the lambda of the last state is not 0, it is recorded once
+  if( (step_ >= maxSteps_) || isStopReached(Cmax_) )
   {
+    if( (int) path_.lambda().size() < path_.size()) { addCmax(nextCmax_);}
+    return false;
+  }
 #ifdef LARS_DEBUG
-  stk_cerr << _T("Lars::run step_ = ") << step_<<endl;
+  stk_cerr << _T("Lars::beginStep step_ = ") << step_<<endl;
 #endif
-    step_++;
-    oldCmax = Cmax;
-    //computation of correlation
-    Cmax = computeCmax();
-    if( Cmax < eps_*100)
-    {
-      step_--;
+  step_++;
+  Real oldCmax = Cmax_;
+  //correlation max computed with the update of c_ at the end of the last step
+  Cmax_ = nextCmax_;
+  if( Cmax_ < eps_*100)
+  {
+    step_--;
 #ifdef LARS_DEBUG
-        std::cout << "Correlation max is equal to 0."<<std::endl;
+      std::cout << "Correlation max is equal to 0."<<std::endl;
 #endif
-      msg_error_ = "Correlation max is equal to 0.";
-      break;
-    }
-    //if correlation max increased, we stop, Cmax must decreased
-    if( Cmax > oldCmax)
-    {//          stk_cout<<Cmax<<endl;
-      step_--;
+    msg_error_ = "Correlation max is equal to 0.";
+    return false;
+  }
+  //if correlation max increased, we stop, Cmax must decreased
+  if( Cmax_ > oldCmax)
+  {
+    step_--;
 #ifdef LARS_DEBUG
-        std::cout << "Correlation max has increased."<<std::endl;
+      std::cout << "Correlation max has increased."<<std::endl;
 #endif
-      msg_error_ = "Correlation max has increased";
-      break;
-    }
-    //add case : update of QR decomposition, active set and X'*X
-    if(isAddCase)
-    {
+    msg_error_ = "Correlation max has increased";
+    return false;
+  }
+  //add case : update of QR decomposition, active set and X'*X
+  if(isAddCase_)
+  {
 #ifdef LARS_DEBUG
-  stk_cerr << _T("Lars::run isAddCase")<<endl;
+  stk_cerr << _T("Lars::beginStep isAddCase")<<endl;
 #endif
-      newId.resize(0);
-      computeAddSet(Cmax, newId);
-      if(newId.size() == 0)
-      {
-        step_--;
+    //newId is computed with the update of c_ at the end of the last step
+    if(newId_.size() == 0)
+    {
+      step_--;
 #ifdef VERBOSE
-          std::cout << "No variable selected for add in the add step."<<std::endl;
+        std::cout << "No variable selected for add in the add step."<<std::endl;
 #endif
-        msg_error_ = "No variable selected for add in the add step.";
-        break;
-      }
-      action.second.erase(action.second.begin(),action.second.end());
-      for(vector<int>::iterator it = newId.begin() ; it != newId.end(); it++)
-      { updateR(*it,signC,action);}
+      msg_error_ = "No variable selected for add in the add step.";
+      return false;
     }
-    else
-    {
-      action=make_pair(false,dropId);
-    }
-    addCmax(Cmax);
-    //compute the inverse of G
-    computeGi1(Gi1,signC);
-    //compute Aa
-    Aa = 1/sqrt(Gi1.sum());
-    //compute w
-    w = Gi1*signC*Aa;
-    //compute equiangular vector
-    u = Xi_*w;
-    //computation of gamma hat
-    //if the number of active variable is equal to the max number authorized, we don't search a new index
-    if( nbActiveVariable_ == min(n_-1, p_-nbIgnoreVariable_) )
-    {  gam = Cmax/Aa;}
-    else
-    {
-      //computation of a
-      a = X_.transpose()*u;
-      //computation of gamma hat
-      gam = computeGamHat(Aa,a,Cmax);
-    }
-    //computation of gamma tilde
-    gammaTilde = computeGamTilde(w,dropId);
-    if( gammaTilde < gam )
-    {
-      gam = gammaTilde;
-      isAddCase = false;
-      nbActiveVariable_ -= dropId.size();
-    }
-    else
-    { isAddCase = true;}
-    //update beta
-    updateBeta(gam,w,action,isAddCase,dropId);
-    //update of c_
-    if( nbActiveVariable_ == min(n_-1, p_-nbIgnoreVariable_) )
+    action_.second.erase(action_.second.begin(),action_.second.end());
+    for(vector<int>::iterator it = newId_.begin() ; it != newId_.end(); it++)
+    { updateR(*it,signC_,action_);}
+  }
+  else
+  {
+    action_.first = false;
+    action_.second.assign(dropId_.begin(),dropId_.end());
+  }
+  addCmax(Cmax_);
+  //compute the inverse of G
+  computeGi1(Gi1_,signC_);
+  //compute Aa
+  Aa_ = computeAa(Gi1_);
+  //compute w
+  computeW(Gi1_,signC_,Aa_,w_);
+  //computation of a = X'*u with u the equiangular vector. Without gram matrix
+  //or cache, a is computed at the end of the step
+  if(useGram_) { computeGramA(w_,a_);}
+  else if(cache_.isEnabled()) { computeCachedA(w_,u_,a_);}
+  else { computeEquiangular(w_,u_);}
+  return true;
+}
+
+/*
+ * end a step: computation of gamma, update of the coefficients and of the correlations
+ * @param p_a pointer on X'*u computed by the caller, NULL for computing it
+ */
+void Lars::endStep(CVectorX const* p_a)
+{
+  bool computeA = false;
+  if(needProduct())
+  {
+    Timings::Timer timer(timings_, Timings::product);
+    if(p_a)
     {
-#ifdef LARS_DEBUG
-  stk_cerr << _T("Lars::run update c_ with nbActiveVariable_ == min(n_-1, p_-nbIgnoreVariable_)")<<endl;
-#endif
-      c_ -= (X_.transpose()*u)*gam;
+      //X is centered implicitly
+      Real sumU = u_.sum();
+      for(int j = a_.begin(); j < a_.end(); j++)
+        a_[j] = (*p_a)[j] - muX_[j] * sumU;
     }
-    else
+    //the variables are not stored: a is computed with a single product
+    else if(!p_X_->hasCheapColumns()) { centeredXtV(u_,a_);}
+    //a is computed with gamma hat
+    else { computeA = true;}
+  }
+  //computation of gamma hat
+  //if the number of active variable is equal to the max number authorized, we don't search a new index
+  if( nbActiveVariable_ == min(n_-1, p_-nbIgnoreVariable_) )
+  {
+    if(computeA)
     {
-#ifdef LARS_DEBUG
-  stk_cerr << _T("Lars::run update c_")<<endl;
-#endif
-      c_ -= a * gam;
+      Timings::Timer timer(timings_, Timings::product);
+      centeredXtV(u_,a_);
     }
-    //drop situation
-    if(!isAddCase) { dropStep(dropId,signC);}
-    //path_.states(step_).printCoeff();
-#ifdef LARS_DEBUG
-  stk_cerr << _T("Lars::run update c_ done")<<endl;
-#endif
+    gam_ = Cmax_/Aa_;
   }
+  else
+  {  gam_ = computeGamHat(Aa_,u_,a_,Cmax_,computeA);}
+  //computation of gamma tilde
+  Real gammaTilde = computeGamTilde(w_,dropId_);
+  if( gammaTilde < gam_ )
+  {
+    gam_ = gammaTilde;
+    isAddCase_ = false;
+    nbActiveVariable_ -= dropId_.size();
+  }
+  else
+  { isAddCase_ = true;}
+  //update beta
+  addRss(gam_,w_);
+  updateBeta(gam_,w_,action_,isAddCase_,dropId_);
+  //drop situation
+  if(!isAddCase_) { dropStep(dropId_,signC_);}
+  //update of c_, correlation max and add set of the next step. a is computed at
+  //each step: after a drop on the last authorized variable, a must not come from an older step
+  nextCmax_ = updateCorrelation(a_,gam_,newId_);
 #ifdef LARS_DEBUG
-  stk_cerr << _T("Lars::run while terminated")<<endl;
-  stk_cerr<<endl<<"Algorithm finished"<<endl;
-  stk_cerr<<"Number of steps: "<<step_<<endl;
-  stk_cerr<<"Number of active variables: "<<nbActiveVariable_<<endl;
-#endif
-
-#ifdef VERBOSE
-  Real t1 = Chrono::elapsed();
-  cout<<endl<<"Algorithm finished in "<<t1<<"s"<<endl;
-  cout<<"Number of steps: "<<step_<<endl;
-  cout<<"Number of active variables: "<<nbActiveVariable_<<endl;
-#endif
-#ifdef LARS_DEBUG
-  stk_cerr << _T("Lars::run done")<<endl;
+  stk_cerr << _T("Lars::endStep update c_ done")<<endl;
 #endif
 }
 
@@ -774,6 +1331,21 @@ void Lars::run()
  */
 void Lars::predict(CArrayXX const& X, Real index, bool lambdaMode, CVectorX &yPred)
 {
+  ArrayDesign design(X);
+  predict(design, index, lambdaMode, yPred);
+}
+
+/*
+ * predict the path for a ratio index = l1norm/l1normmax or a specific value of lambda
+ * @param X new design for predict the response
+ * @param index index (lambda or fraction) where the response is estimated.
+ * @param lambdaMode if TRUE, index corresponds to a value of lambda, if FALSE, index is a real between 0 and 1
+ * corresponding to ratio between the l1 norm of estimates to calculate and l1 norm max of solution
+ * @param predicted response (be modified)
+ */
+void Lars::predict(IDesign const& X, Real index, bool lambdaMode, CVectorX &yPred)
+{
+  Timings::Timer timer(timings_, Timings::predict);
 #ifdef LARS_DEBUG
 stk_cerr << _T("Entering Lars::predict")<<endl;
 #endif
@@ -789,11 +1361,13 @@ stk_cerr << _T("Entering Lars::predict")<<endl;
   if( ((index == 1.) && !lambdaMode) || ((index <= path_.lambda().back()) && lambdaMode) )
   {
     int lastStep = path_.size()-1;//stocké dans un vector index à 0
-    int nbVar = path_.lastState().sizeRows();
+    int nbVar = path_.size(lastStep);
 
-    for(int i = yPred.begin(); i < yPred.end(); i++)
-      for(int j = 1; j <= nbVar; j++)
-        yPred[i] += (X(i, varIdx(lastStep,j)) -muX_[varIdx(lastStep,j)]) * coefficient(lastStep,j);
+    for(int j = 1; j <= nbVar; j++)
+    {
+      X.addCol(varIdx(lastStep,j), coefficient(lastStep,j), yPred);
+      yPred -= muX_[varIdx(lastStep,j)] * coefficient(lastStep,j);
+    }
 #ifdef LARS_DEBUG
   stk_cerr << _T("Lars::predict done")<<endl;
 #endif
@@ -836,14 +1410,172 @@ stk_cerr << _T("Entering Lars::predict")<<endl;
   //coeff.move(computeCoefficients(path_.states(ind-2),path_.states(ind-1),path_.evolution(ind-2),fraction));
   computeCoefficients(path_.states(ind-2),path_.states(ind-1),path_.evolution(ind-2),l1normNew,coeff);
 
-  for( int i = yPred.begin(); i < yPred.end(); i++)
-    for( int j = 1; j <= coeff.sizeRows(); j++)
-      yPred[i] += (X(i, coeff[j].first) - muX_[coeff[j].first] ) * coeff[j].second ;
+  for( int j = 1; j <= coeff.sizeRows(); j++)
+  {
+    X.addCol(coeff[j].first, coeff[j].second, yPred);
+    yPred -= muX_[coeff[j].first] * coeff[j].second;
+  }
 #ifdef LARS_DEBUG
   stk_cerr << _T("Lars::predict done")<<endl;
 #endif
 }
 
+/*
+ * predict the path for several index
+ * @param X new design for predict the response
+ * @param index indexes (lambda or fraction) where the response is estimated.
+ * @param lambdaMode if TRUE, index contains values of lambda, if FALSE, reals between 0 and 1
+ * @param yPred container for the predicted responses, the column s for index[s-1] (be modified)
+ */
+void Lars::predict(IDesign const& X, std::vector<Real> const& index, bool lambdaMode, CArrayXX &yPred)
+{
+  Timings::Timer timer(timings_, Timings::predict);
+#ifdef LARS_DEBUG
+stk_cerr << _T("Entering Lars::predict (several index)")<<endl;
+#endif
+  int nbIndex = index.size();
+  yPred.resize(Range(1,X.sizeRows()), Range(1,nbIndex));
+  yPred = mu_;
+  //no step: all coefficients are equal to 0
+  if(path_.size() == 1) return;
+
+  //the indexes are sorted by segment of the path
+  vector< pair<int,int> > order(nbIndex);
+  vector<Real> weight(nbIndex);
+  for(int s = 0; s < nbIndex; s++)
+  {
+    locateIndex(index[s], lambdaMode, order[s].first, weight[s]);
+    order[s].second = s;
+  }
+  sort(order.begin(), order.end());
+
+  //current coefficients, their prediction and the prediction of the previous state
+  CVectorX beta(Range(1,p_), 0.), target(Range(1,p_), 0.);
+  CVectorX yCur(Range(1,X.sizeRows()), mu_), yPrev(Range(1,X.sizeRows()), mu_);
+  vector<int> support;
+  int knot = 0;
+  for(int begin = 0, end = 0; begin < nbIndex; begin = end)
+  {
+    int state = order[begin].first;
+    while( (end < nbIndex) && (order[end].first == state) ) { end++;}
+    if(end - begin == 1)
+    {
+      //a single index on the segment: its coefficients are computed directly
+      moveCoefficients(X, state, weight[order[begin].second], beta, target, support, yCur);
+      knot = -1;
+      int col = order[begin].second + 1;
+      for(int i = yPred.beginRows(); i < yPred.endRows(); i++) { yPred(i,col) = yCur[i];}
+    }
+    else
+    {
+      //the predictions of the two states of the segment are computed once, the coefficients being
+      //linear between two states, so are the predictions
+      if(knot != state-1) { moveCoefficients(X, state, 0., beta, target, support, yCur);}
+      yPrev = yCur;
+      moveCoefficients(X, state, 1., beta, target, support, yCur);
+      knot = state;
+      for(int s = begin; s < end; s++)
+      {
+        Real w = weight[order[s].second];
+        int col = order[s].second + 1;
+        for(int i = yPred.beginRows(); i < yPred.endRows(); i++)
+        { yPred(i,col) = yPrev[i] + w * (yCur[i] - yPrev[i]);}
+      }
+    }
+  }
+#ifdef LARS_DEBUG
+  stk_cerr << _T("Lars::predict (several index) done")<<endl;
+#endif
+}
+
+/*
+ * locate an index on the path
+ * @param index index (lambda or fraction)
+ * @param lambdaMode if TRUE, index corresponds to a value of lambda, if FALSE, to a fraction of the l1norm max
+ * @param state state of the path, between 1 and the last state
+ * @param weight weight of the state state, between 0 and 1
+ */
+void Lars::locateIndex(Real index, bool lambdaMode, int& state, Real& weight) const
+{
+  //same cases as predict for a single index
+  if( ((index == 0.) && !lambdaMode) || ((index>=path_.lambda(0)) && lambdaMode) )
+  {
+    state = 1;
+    weight = 0.;
+    return;
+  }
+  int lastState = path_.size()-1;
+  if( ((index == 1.) && !lambdaMode) || ((index <= path_.lambda().back()) && lambdaMode) )
+  {
+    state = lastState;
+    weight = 1.;
+    return;
+  }
+  state = 1;
+  if(lambdaMode)
+  {
+    while(path_.lambda(state) > index) { state++;}
+    weight = (index - path_.lambda(state-1))/(path_.lambda(state) - path_.lambda(state-1));
+  }
+  else
+  {
+    Real l1normNew = index * path_.l1norm(lastState);
+    while(path_.l1norm(state) < l1normNew) { state++;}
+    weight = (l1normNew - path_.l1norm(state-1))/(path_.l1norm(state) - path_.l1norm(state-1));
+  }
+}
+
+/*
+ * move the coefficients beta to (1-weight) * coefficients of the state state-1 + weight * coefficients of
+ * the state state and update their prediction with the changed coefficients only
+ * @param X design of the prediction
+ * @param state state of the path
+ * @param weight weight of the state state
+ * @param beta current coefficients (be modified)
+ * @param target workspace of size p, zero outside support
+ * @param support variables with a non zero coefficient in beta (be modified)
+ * @param yPred prediction of beta (be modified)
+ */
+void Lars::moveCoefficients( IDesign const& X, int state, Real weight
+                           , CVectorX& beta, CVectorX& target, vector<int>& support, CVectorX& yPred) const
+{
+  for(int j = 0; j < (int) support.size(); j++) { target[support[j]] = 0.;}
+  for(int j = 1; j <= path_.size(state-1); j++)
+  { target[path_.varIdx(state-1,j)] += (1.-weight) * path_.varCoeff(state-1,j);}
+  for(int j = 1; j <= path_.size(state); j++)
+  { target[path_.varIdx(state,j)] += weight * path_.varCoeff(state,j);}
+  //the old and new supports, a variable seen twice has a zero delta the second time
+  for(int j = 0; j < (int) support.size(); j++) { moveCoefficient(X, support[j], beta, target, yPred);}
+  support.clear();
+  for(int j = 1; j <= path_.size(state-1); j++)
+  {
+    moveCoefficient(X, path_.varIdx(state-1,j), beta, target, yPred);
+    support.push_back(path_.varIdx(state-1,j));
+  }
+  for(int j = 1; j <= path_.size(state); j++)
+  {
+    moveCoefficient(X, path_.varIdx(state,j), beta, target, yPred);
+    support.push_back(path_.varIdx(state,j));
+  }
+}
+
+/*
+ * move the coefficient j of beta to target[j] and update its prediction
+ * @param X design of the prediction
+ * @param j index of the variable
+ * @param beta current coefficients (be modified)
+ * @param target new coefficients
+ * @param yPred prediction of beta (be modified)
+ */
+void Lars::moveCoefficient(IDesign const& X, int j, CVectorX& beta, CVectorX const& target, CVectorX& yPred) const
+{
+  Real delta = target[j] - beta[j];
+  if(delta == 0.) return;
+  X.addCol(j, delta, yPred);
+  yPred -= muX_[j] * delta;
+  beta[j] = target[j];
+}
+
 void Lars::computeCoefficients(PathState const& state1,PathState const& state2,pair<std::vector<int> ,std::vector<int> > const& evolution, Real const& l1norm, Array2DVector< pair<int,Real> > &coeff)
 {
   //Array2DVector< pair<int,Real> > coeff(std::max(state1.size(),state2.size()));
@@ -61,24 +61,83 @@ namespace HD
       //constructors
       /**
        * Constructor
-       * @param X matrix of data, a row=a individual
+       * @param X matrix of data, a row=a individual. X is not copied and must exist as long as the object
        * @param y response
        * @param intercept if true there is an intercept in the model
        */
       Lars(STK::CArrayXX const& X, STK::CVectorX const& y, bool intercept = true);
       /**
        * Constructor
-       * @param X matrix of data, a row=a individual
+       * @param X matrix of data, a row=a individual. X is not copied and must exist as long as the object
        * @param y response
        * @param maxSteps number of maximum step to do
        * @param intercept if true there is an intercept in the model
        * @param eps epsilon (for 0)
+       * @param useGram if true, X'X is computed once and the correlations are updated in the space of the variables
+       * @param cacheSize memory cap (in MB) of the cache of the columns X'x_j of the active variables, 0 for no cache.
+       * Not used if useGram is true.
        */
       Lars( STK::CArrayXX const& X
           , STK::CVectorX const& y
           , int maxSteps
           , bool intercept=true
+          , STK::Real eps =STK::Arithmetic<STK::Real>::epsilon()
+          , bool useGram = false
+          , STK::Real cacheSize = 0.);
+      /**
+       * Constructor
+       * @param X design, a row=a individual. X is not copied and must exist as long as the object
+       * @param y response
+       * @param maxSteps number of maximum step to do
+       * @param intercept if true there is an intercept in the model
+       * @param eps epsilon (for 0)
+       * @param useGram if true, X'X is computed once and the correlations are updated in the space of the variables
+       * @param cacheSize memory cap (in MB) of the cache of the columns X'x_j of the active variables, 0 for no cache.
+       * Not used if useGram is true.
+       */
+      Lars( IDesign const& X
+          , STK::CVectorX const& y
+          , int maxSteps
+          , bool intercept=true
+          , STK::Real eps =STK::Arithmetic<STK::Real>::epsilon()
+          , bool useGram = false
+          , STK::Real cacheSize = 0.);
+      /**
+       * Constructor with a Gram matrix computed by the caller. The correlations are updated in the space
+       * of the variables (useGram mode) and X'X is not computed from X.
+       * @param X design, a row=a individual. X is not copied and must exist as long as the object
+       * @param y response
+       * @param gram X'X of size p*p, computed with X centered if intercept is true
+       * @param maxSteps number of maximum step to do
+       * @param intercept if true there is an intercept in the model
+       * @param eps epsilon (for 0)
+       */
+      Lars( IDesign const& X
+          , STK::CVectorX const& y
+          , STK::CArrayXX const& gram
+          , int maxSteps
+          , bool intercept=true
+          , STK::Real eps =STK::Arithmetic<STK::Real>::epsilon());
+      /**
+       * Constructor with the means of the variables and the correlations computed by the caller,
+       * e.g. for several responses sharing the same design (see @c MultiLars).
+       * @param X design, a row=a individual. X is not copied and must exist as long as the object
+       * @param y response
+       * @param muX mean of each variable of X (not used if intercept is false)
+       * @param xty correlations X'*(y-mean(y)) with X centered if intercept is true, X'*y otherwise
+       * @param maxSteps number of maximum step to do
+       * @param intercept if true there is an intercept in the model
+       * @param eps epsilon (for 0)
+       */
+      Lars( IDesign const& X
+          , STK::CVectorX const& y
+          , STK::CVectorX const& muX
+          , STK::CVectorX const& xty
+          , int maxSteps
+          , bool intercept=true
           , STK::Real eps =STK::Arithmetic<STK::Real>::epsilon());
+      /** destructor*/
+      ~Lars();
 
       //getters
       /**@return path of the coefficients*/
@@ -87,7 +146,7 @@ namespace HD
        * @param i step
        * @return the Pathstate object : the state of the path at the step i
        */
-      inline PathState const& path(int i) const {return path_.states(i);}
+      inline PathState path(int i) const {return path_.states(i);}
       /**
        * @param i index of the step
        * @param j index of the coefficients
@@ -107,10 +166,12 @@ namespace HD
       inline STK::Real l1norm(int i) const {return path_.l1norm(i);}
       /** @return the vector of l1norm*/
       inline STK::VectorX const l1norm() const {return path_.l1norm();}
-      /** @return the vector of lambda*/
+      /** @return the vector of lambda. The lambda of the last state is stored only if the path is truncated, 0 otherwise*/
       inline std::vector<STK::Real> const lambda() const {return path_.lambda();}
       /** @return the historic of add and drop variable*/
       inline std::vector< std::pair<std::vector<int> ,std::vector<int> > > evolution() const {return path_.evolution();}
+      /** @return the add and drop variables of the step i+1*/
+      inline std::pair<std::vector<int> ,std::vector<int> > evolution(int i) const {return path_.evolution(i);}
       /**@return Number of step of the algorithm*/
       inline int step() const {return step_;}
       /** @return the intercept of the solution*/
@@ -123,11 +184,79 @@ namespace HD
       inline STK::CVectorX muX() const {return muX_;}
       /**@return muX_[i]*/
       inline STK::Real muX(int i) const {return muX_[i];}
+      /**@return residual sum of squares of each state of the path*/
+      inline std::vector<STK::Real> const& rss() const {return rss_;}
+      /**@return number of columns of X'X found in the cache*/
+      inline int cacheHits() const {return cache_.nbHit();}
+      /**@return number of columns of X'X computed from X*/
+      inline int cacheMisses() const {return cache_.nbMiss();}
+      /**@return cumulative time and number of calls of each phase of the algorithm*/
+      inline Timings const& timings() const {return timings_;}
+
+      //setters
+      /**
+       * stop the algorithm once the path reaches a lambda lower than minLambda. The last step crosses minLambda,
+       * so the path can be interpolated (see predict) for every lambda >= minLambda.
+       * @param minLambda lower bound of the lambda of interest
+       */
+      inline void setMinLambda(STK::Real minLambda) {minLambda_ = minLambda;}
+      /**
+       * stop the algorithm once the number of active variables reaches maxNbActive
+       * @param maxNbActive maximal number of active variables
+       */
+      inline void setMaxNbActiveVariables(int maxNbActive) {maxNbActive_ = maxNbActive;}
+      /**
+       * stop the algorithm once the l1 norm of the coefficients reaches maxL1norm
+       * @param maxL1norm maximal l1 norm of the coefficients
+       */
+      inline void setMaxL1norm(STK::Real maxL1norm) {maxL1norm_ = maxL1norm;}
+      /**
+       * factorize the Gram matrix of the active variables with a Cholesky factor instead of the QR
+       * decomposition of the active columns of X. The memory used by the active set is O(k^2) instead
+       * of O(nk). Must be called before run.
+       * @param useCholesky if true, use the Cholesky factor
+       */
+      inline void setCholesky(bool useCholesky) {useCholesky_ = useCholesky;}
+      /**
+       * reserve the memory of the coefficients of the path. Without it, the arrays of the path
+       * grow geometrically during the steps. Must be called before run.
+       * @param nbCoefficients number of coefficients of all the states of the path (@see Path::nbCoefficients)
+       */
+      inline void reservePath(int nbCoefficients) {path_.reserve(nbCoefficients);}
+      /**
+       * compute inv(Xi'*Xi)*1 at each step with one triangular solve per active variable, O(k^3),
+       * instead of the incremental O(k^2) solve. Used to check the incremental solve. Must be called before run.
+       * @param useReferenceSolve if true, use the reference solve
+       */
+      inline void setReferenceSolve(bool useReferenceSolve) {useReferenceSolve_ = useReferenceSolve;}
 
       //methods
       /** run lars algorithm*/
       void run();
 
+      /**
+       * The algorithm can be run step by step: start, then beginStep and endStep while beginStep
+       * returns true. Between the two, the product a = X'*u of the equiangular vector can be
+       * computed by the caller (see needProduct), e.g. for several paths at once.
+       * @return false if the algorithm stops at the first step
+       */
+      bool start();
+      /**
+       * begin a step: update of the active set, computation of the equiangular vector and,
+       * with the Gram matrix or the cache, of a = X'*u.
+       * @return false if the algorithm stops
+       */
+      bool beginStep();
+      /**
+       * end a step: computation of gamma, update of the coefficients and of the correlations
+       * @param p_a pointer on X'*u computed by the caller (X not centered), NULL for computing it
+       */
+      void endStep(STK::CVectorX const* p_a = 0);
+      /** @return true if a = X'*u is computed from X at the end of the current step*/
+      inline bool needProduct() const {return !useGram_ && !cache_.isEnabled();}
+      /** @return the equiangular vector of the current step (valid if needProduct is true)*/
+      inline STK::CVectorX const& equiangular() const {return u_;}
+
       /**
        * predict the path for a ratio fraction = l1norm/l1normmax
        * @param X new data for predict the response
@@ -137,10 +266,31 @@ namespace HD
        * @param yPred container for the predicted response (will be modified)
        */
       void predict(STK::CArrayXX const& X, STK::Real index, bool lambdaMode, STK::CVectorX &yPred);
+      /**
+       * predict the path for a ratio fraction = l1norm/l1normmax
+       * @param X new design for predict the response
+       * @param index index (lambda or fraction) where the response is estimated.
+       * @param lambdaMode if TRUE, index corresponds to a value of lambda, if FALSE, index is a real between 0 and 1
+       * corresponding to ratio between the l1 norm of estimates to calculate and l1 norm max of solution
+       * @param yPred container for the predicted response (will be modified)
+       */
+      void predict(IDesign const& X, STK::Real index, bool lambdaMode, STK::CVectorX &yPred);
+      /**
+       * predict the path for several index. The prediction is updated from one index to the next with the
+       * changed coefficients only. When several index lie between the same two states of the path, the
+       * predictions of the two states are computed once and the predictions of the index are interpolated.
+       * @param X new design for predict the response
+       * @param index indexes (lambda or fraction) where the response is estimated.
+       * @param lambdaMode if TRUE, index contains values of lambda, if FALSE, reals between 0 and 1
+       * corresponding to ratio between the l1 norm of estimates to calculate and l1 norm max of solution
+       * @param yPred container for the predicted responses, the column s for index[s-1] (will be modified)
+       */
+      void predict(IDesign const& X, std::vector<STK::Real> const& index, bool lambdaMode, STK::CArrayXX &yPred);
 
    protected:
       /**
-       * initialization of algorithm
+       * initialization of algorithm. The means of X and the correlations are computed
+       * only if they are not given to the constructor.
        */
       void initialization();
 
@@ -152,7 +302,7 @@ namespace HD
       void computeAddSet(STK::Real Cmax, std::vector<int>& newId) const;
 
       /**
-       * update the QR decomposition of Xi
+       * update the QR decomposition of Xi or the Cholesky factor of Xi'Xi
        * @param idxVar index of active variable to add
        * @param signC sign of correlation of active variable
        * @param action a pair with first element is a bool (true for addcase, false for dropcase) and second the idx variable to drop/add
@@ -160,11 +310,91 @@ namespace HD
       void updateR(int idxVar, STK::VectorXi &signC, std::pair<bool,std::vector<int> > &action);
 
       /**
-       * compute inv(Xi'*Xi)*1 from qr decomposition
+       * compute inv(Xi'*Xi)*1 from qr decomposition. The forward solve R'*v=signC
+       * is kept in v_ between two steps: only the entries invalidated by the
+       * last add (resp. drop) are computed, then a single back substitution
+       * gives Gi1. The cost of a step is thus O(k^2) instead of O(k^3).
+       * @param Gi1 for stock inv(Xi'*Xi)*1, of size at least nbActiveVariable_
+       * @param signC sign of correlation of active variable
+       */
+      void computeGi1(STK::CVectorX &Gi1, STK::VectorXi const& signC);
+      /**
+       * @param Gi1 inv(Xi'*Xi)*1 @see computeGi1
+       * @return Aa = 1/sqrt(1'*inv(Xi'*Xi)*1)
+       */
+      STK::Real computeAa(STK::CVectorX const& Gi1) const;
+      /**
+       * compute w = Aa*Gi1 with the signs of the correlations
+       * @param Gi1 inv(Xi'*Xi)*1 @see computeGi1
+       * @param signC sign of correlation of active variable
+       * @param Aa @see computeAa
+       * @param w result, only the nbActiveVariable_ first elements are computed
+       */
+      void computeW(STK::CVectorX const& Gi1, STK::VectorXi const& signC, STK::Real Aa, STK::CVectorX &w) const;
+      /**
+       * compute inv(Xi'*Xi)*1 from qr decomposition by solving the nbActiveVariable_
+       * triangular systems R'*v=signC(i)*e_i. Used as a reference for computeGi1.
        * @param Gi1 for stock inv(Xi'*Xi)*1
        * @param signC sign of correlation of active variable
        */
-      void computeGi1(STK::CVectorX &Gi1, STK::VectorXi const& signC) const;
+      void computeGi1Reference(STK::CVectorX &Gi1, STK::VectorXi const& signC) const;
+
+      /**
+       * @param i, j index of the element, i <= j
+       * @return the element (i,j) of the triangular factor of the Gram matrix of the active variables
+       */
+      inline STK::Real factorR(int i, int j) const {return useCholesky_ ? cholR_(i,j) : qrX_(i,j);}
+
+      /**
+       * add the variable idxVar to the Cholesky factor
+       * @param idxVar index of the variable to add
+       * @return false if the variable is colinear with the active variables
+       */
+      bool addCholesky(int idxVar);
+
+      /**
+       * compute the equiangular vector u = Xi*w. Xi is not stored, u is computed from the active
+       * columns of X through Xa_.
+       * @param w Aa*Gi1 @see computeGi1
+       * @param u equiangular vector
+       */
+      void computeEquiangular(STK::CVectorX const& w, STK::CVectorX &u) const;
+
+      /**
+       * compute the centered column j of X
+       * @param j index of the variable
+       * @param xc x_j - muX_[j]
+       */
+      void centeredCol(int j, STK::CVectorX &xc) const;
+
+      /**
+       * compute the product of the centered X by a vector: X'*v - muX_*sum(v)
+       * @param v vector of size n
+       * @param a result of size p
+       */
+      void centeredXtV(STK::CVectorX const& v, STK::CVectorX &a) const;
+
+      /**
+       * compute a = X'*u = X'*Xi*w using the Gram matrix (useGram_ mode)
+       * @param w Aa*Gi1 @see computeGi1
+       * @param a X' * equiangular vector
+       */
+      void computeGramA(STK::CVectorX const& w, STK::CVectorX &a) const;
+
+      /**
+       * compute a = X'*u = X'*Xi*w using the cached columns of X'X. The active
+       * variables missing in the cache are taken into account with a product by X'.
+       * @param w Aa*Gi1 @see computeGi1
+       * @param u work vector of size n
+       * @param a X' * equiangular vector
+       */
+      void computeCachedA(STK::CVectorX const& w, STK::CVectorX &u, STK::CVectorX &a);
+
+      /**
+       * put the column X'x_idxVar in the cache if it is not there
+       * @param idxVar index of the added variable
+       */
+      void cacheGramCol(int idxVar);
 
       /**
        * compute Cmax
@@ -186,13 +416,28 @@ namespace HD
       void dropStep(std::vector<int> const& idxVar, STK::VectorXi &signC);
 
       /**
-       * Compute gammahat for the update of coefficient in add case
+       * Compute gammahat for the update of coefficient in add case. The columns
+       * are processed by blocks (in parallel with openMP). If computeA is true,
+       * a_j = x_j'*u is computed in the same pass.
        * @param Aa norm of the inverse of G
-       * @param a X' * equiangular vector
+       * @param u equiangular vector
+       * @param a X' * equiangular vector (computed if computeA is true)
        * @param Cmax correlation max
+       * @param computeA if true, compute a from X and u
        * @return gammaHat a real
        */
-      STK::Real computeGamHat(STK::Real const& Aa, STK::CVectorX const& a, STK::Real Cmax) const;
+      STK::Real computeGamHat(STK::Real const& Aa, STK::CVectorX const& u, STK::CVectorX &a, STK::Real Cmax, bool computeA);
+
+      /**
+       * update the correlations c_ -= gamma*a and, in the same pass over the
+       * variables, compute the correlation max and the add set of the next step.
+       * The columns are processed by blocks (in parallel with openMP).
+       * @param a X' * equiangular vector
+       * @param gamma step of the update
+       * @param newId a vector containing the index of variable to potentially add at the next step
+       * @return the correlation max of the next step
+       */
+      STK::Real updateCorrelation(STK::CVectorX const& a, STK::Real gamma, std::vector<int>& newId);
 
       /**
        * Compute gammaTilde for the update of coefficient in drop case
@@ -210,12 +455,13 @@ namespace HD
        * @param isAddCase true if we add a variable
        * @param dropId id top potentially drop
        */
-      void updateBeta(STK::Real gamma, STK::CVectorX const& w, std::pair<bool,std::vector<int> > action, bool isAddCase, std::vector<int> dropId);
+      void updateBeta(STK::Real gamma, STK::CVectorX const& w, std::pair<bool,std::vector<int> > const& action, bool isAddCase, std::vector<int> const& dropId);
 
       /**
        * first step
        * @param Cmax correlation max
-       * @param newId vector of index of active variable to add
+       * @param nextCmax correlation max of the second step
+       * @param newId vector of index of active variable to add (at the end: add set of the second step)
        * @param signC sign of correlation of active variable
        * @param action a pair with first element is a bool (true for addcase, false for dropcase) and second the idx variable to drop/add
        * @param Aa norm of the inverse of G
@@ -227,6 +473,7 @@ namespace HD
        * @return
        */
       bool firstStep( STK::Real &Cmax
+                    , STK::Real &nextCmax
                     , std::vector<int> &newId
                     , STK::VectorXi &signC
                     , std::pair<bool,std::vector<int> > &action
@@ -234,11 +481,60 @@ namespace HD
                     , STK::CVectorX &Gi1, STK::CVectorX &w, STK::CVectorX &u, STK::CVectorX &a
                     , STK::Real &gam);
 
+      /**
+       * add the residual sum of squares of the next state. The coefficients move by gamma*w, so the
+       * prediction moves by gamma*u with u the equiangular vector (of norm 1) and
+       * rss = rss - 2*gamma*u'r + gamma^2, with u'r = sum_k w_k c_k computed with the correlations
+       * of the active variables. Must be called before the update of c_.
+       * @param gamma step of the update
+       * @param w Aa*Gi1 @see computeGi1
+       */
+      void addRss(STK::Real gamma, STK::CVectorX const& w);
+
+      /**
+       * check the early stopping criteria set with setMinLambda, setMaxNbActiveVariables and setMaxL1norm
+       * @param Cmax lambda at the beginning of the last step
+       * @return true if the algorithm must stop
+       */
+      bool isStopReached(STK::Real Cmax) const;
+
       /**
        * updateR only for the first step
        * @see updateR
        */
       void firstUpdateR(int idxVar, STK::VectorXi &signC, std::pair<bool,std::vector<int> > &action);
+      /**
+       * locate an index on the path: the coefficients of index are (1-weight) times the coefficients
+       * of the state state-1 plus weight times the coefficients of the state state
+       * @param index index (lambda or fraction)
+       * @param lambdaMode if TRUE, index corresponds to a value of lambda, if FALSE, to a fraction of the l1norm max
+       * @param state state of the path, between 1 and the last state
+       * @param weight weight of the state state, between 0 and 1
+       */
+      void locateIndex(STK::Real index, bool lambdaMode, int& state, STK::Real& weight) const;
+      /**
+       * move the coefficients beta to (1-weight) * coefficients of the state state-1 + weight * coefficients
+       * of the state state and update their prediction with the changed coefficients only
+       * @param X design of the prediction
+       * @param state state of the path
+       * @param weight weight of the state state
+       * @param beta current coefficients (will be modified)
+       * @param target workspace of size p, zero outside support
+       * @param support variables with a non zero coefficient in beta (will be modified)
+       * @param yPred prediction of beta (will be modified)
+       */
+      void moveCoefficients( IDesign const& X, int state, STK::Real weight
+                           , STK::CVectorX& beta, STK::CVectorX& target, std::vector<int>& support
+                           , STK::CVectorX& yPred) const;
+      /**
+       * move the coefficient j of beta to target[j] and update its prediction
+       * @param X design of the prediction
+       * @param j index of the variable
+       * @param beta current coefficients (will be modified)
+       * @param target new coefficients
+       * @param yPred prediction of beta (will be modified)
+       */
+      void moveCoefficient(IDesign const& X, int j, STK::CVectorX& beta, STK::CVectorX const& target, STK::CVectorX& yPred) const;
       /**
        * Compute the coefficients for a given value of lambda
        * @param state1 state of a lars step
@@ -254,20 +550,36 @@ namespace HD
                               , STK::Real const& lambda
                               , STK::Array2DVector< std::pair<int,STK::Real> > &coeff);
     private:
+      /** no copy: the object can own its design*/
+      Lars(Lars const&);
+      Lars& operator=(Lars const&);
+      ///number of variables in a block of the passes over the columns of X
+      static const int blockSize_ = 256;
       ///number of individuals
       int n_;
       ///number of variables
       int p_;
       /// maximal number of steps
       int maxSteps_;
-      ///covariate size n*p
-      STK::CArrayXX X_;
+      ///the algorithm stops once lambda is lower than minLambda_ (0 by default)
+      STK::Real minLambda_;
+      ///the algorithm stops once the number of active variables reaches maxNbActive_ (p by default)
+      int maxNbActive_;
+      ///the algorithm stops once the l1 norm of the coefficients reaches maxL1norm_ (no limit by default)
+      STK::Real maxL1norm_;
+      ///design created by the object when it is constructed with a STK::CArrayXX, NULL otherwise
+      IDesign* p_ownDesign_;
+      ///pointer on the design size n*p. The data are not copied and never centered:
+      ///centering is done implicitly with muX_
+      IDesign const* p_X_;
       ///response size p*1
       STK::CVectorX y_;
       ///mean of each covariate of X
       STK::CVectorX muX_;
       /// path solution
       Path path_;
+      /// residual sum of squares of each state of the path
+      std::vector<STK::Real> rss_;
       /// current active variable (non zero coefficient)
       STK::CArrayVector<bool> isActive_;
       ///index of variables to ignore because it causes singularity
@@ -284,16 +596,64 @@ namespace HD
       STK::Real mu_;
       ///eps for zero approximation
       STK::Real eps_;
-      ///X reduced to covariates of active Set
-      STK::ArrayXX Xi_;
+      ///view on the centered covariates of the active set, Xi is never copied
+      ActiveColumns Xa_;
       ///qr decomposition of Xi
-      STK::lapack::Qr qrX_;
+      QrFactor qrX_;
+      /// if true, the Gram matrix of the active variables is factorized with cholR_ instead of qrX_
+      bool useCholesky_;
+      ///Cholesky factor of Xi'Xi
+      Cholesky cholR_;
+      /// if true, computeGi1 uses the O(k^3) solve of computeGi1Reference
+      bool useReferenceSolve_;
+      ///buffers of the steps
+      LarsWorkspace work_;
+      ///time spent in each phase, mutable for timing the const methods
+      mutable Timings timings_;
+      ///solution of R'*v=signC, only the nbValidV_ first elements are up to date
+      STK::CVectorX v_;
+      ///number of elements of v_ which are still valid for the current R
+      int nbValidV_;
       /// vector of correlation (size p*1)
       STK::CVectorX c_;
       /// if true, there is an intercept in the model
       bool intercept_;
+      /// if true, a and c_ are computed from gram_ instead of X
+      bool useGram_;
+      /// X'X (computed with the centered X) if useGram_ is true, empty otherwise
+      STK::CArrayXX gram_;
+      /// cache of the columns of X'X for the active variables
+      GramCache cache_;
       ///last error message
       std::string msg_error_;
+
+      //state of the algorithm kept between two steps (set by start)
+      ///true if the last step added variables
+      bool isAddCase_;
+      ///variables dropped at the last step
+      std::vector<int> dropId_;
+      ///variables to add at the next step
+      std::vector<int> newId_;
+      ///norm of the inverse of G
+      STK::Real Aa_;
+      ///step of the update of the coefficients
+      STK::Real gam_;
+      ///correlation max of the current step
+      STK::Real Cmax_;
+      ///correlation max of the next step
+      STK::Real nextCmax_;
+      ///inv(Xi'*Xi)*1, only the nbActiveVariable_ first elements are used
+      STK::CVectorX Gi1_;
+      ///Aa*Gi1, only the nbActiveVariable_ first elements are used
+      STK::CVectorX w_;
+      ///sign of the correlations of the active variables
+      STK::VectorXi signC_;
+      ///X' * equiangular vector
+      STK::CVectorX a_;
+      ///equiangular vector
+      STK::CVectorX u_;
+      ///added or dropped variables of the current step
+      std::pair<bool,std::vector<int> > action_;
   };
 
 }//end namespace
@@ -0,0 +1,76 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file LarsWorkspace.cpp
+ *  @brief Code of methods associates to @c LarsWorkspace.
+ **/
+
+#include "../larsRmain.h"
+
+using namespace STK;
+using namespace std;
+
+namespace HD
+{
+/* default constructor: empty buffers*/
+LarsWorkspace::LarsWorkspace() : xc_(Range(1,0)), g_(Range(1,0)), gramCol_(Range(1,0)), aMissing_(Range(1,0))
+                               , blockGamHat_(), blockCmax_(), blockId_(), drop_(), noDrop_()
+{}
+
+/*
+ * allocate the buffers
+ * @param n number of individuals
+ * @param p number of variables
+ * @param kMax maximal number of active variables
+ * @param blockSize number of variables of a block of the parallel loops
+ * @param useCache if true, allocate the buffers used with the cache of X'X
+ */
+void LarsWorkspace::reserve(int n, int p, int kMax, int blockSize, bool useCache)
+{
+  int nbBlock = (p + blockSize - 1)/blockSize;
+  xc_.resize(Range(1,n));
+  g_.resize(Range(1,kMax));
+  if(useCache)
+  {
+    gramCol_.resize(Range(1,p));
+    aMissing_.resize(Range(1,p));
+  }
+  blockGamHat_.resize(nbBlock);
+  blockCmax_.resize(nbBlock);
+  blockId_.resize(nbBlock);
+  for(int b = 0; b < nbBlock; b++)
+  {
+    blockId_[b].clear();
+    blockId_[b].reserve(blockSize);
+  }
+  drop_.reserve(kMax);
+}
+
+}//end namespace HD
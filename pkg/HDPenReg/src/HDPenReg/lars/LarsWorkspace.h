@@ -0,0 +1,82 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file LarsWorkspace.h
+ *  @brief In this file, we define the struct @c LarsWorkspace.
+ **/
+
+
+#ifndef LARSWORKSPACE_H_
+#define LARSWORKSPACE_H_
+
+namespace HD
+{
+/**
+ * Buffers of the steps of the lars algorithm. They are allocated once by
+ * reserve, before the first step, with the maximal number of active variables:
+ * a step of the algorithm only uses the first elements of the buffers and
+ * does not allocate memory.
+ */
+  struct LarsWorkspace
+  {
+      /** default constructor: empty buffers*/
+      LarsWorkspace();
+      /**
+       * allocate the buffers
+       * @param n number of individuals
+       * @param p number of variables
+       * @param kMax maximal number of active variables
+       * @param blockSize number of variables of a block of the parallel loops
+       * @param useCache if true, allocate the buffers used with the cache of X'X
+       */
+      void reserve(int n, int p, int kMax, int blockSize, bool useCache);
+
+      ///centered column of an added variable (size n)
+      STK::CVectorX xc_;
+      ///cross products of an added variable with the active variables (size kMax)
+      STK::CVectorX g_;
+      ///column X'x of an added variable put in the cache (size p)
+      STK::CVectorX gramCol_;
+      ///part of X'u computed from X for the variables missing in the cache (size p)
+      STK::CVectorX aMissing_;
+      ///gamma hat of each block of variables
+      std::vector<STK::Real> blockGamHat_;
+      ///correlation max of each block of variables
+      std::vector<STK::Real> blockCmax_;
+      ///candidates to add of each block of variables
+      std::vector< std::vector<int> > blockId_;
+      ///index of the dropped variables
+      std::vector<int> drop_;
+      ///empty list of dropped variables, for the steps without drop
+      std::vector<int> noDrop_;
+  };
+}//end namespace HD
+
+#endif /* LARSWORKSPACE_H_ */
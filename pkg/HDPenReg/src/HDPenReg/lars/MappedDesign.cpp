@@ -0,0 +1,264 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file MappedDesign.cpp
+ *  @brief Code of methods associates to @c MappedDesign.
+ **/
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "../larsRmain.h"
+
+using namespace STK;
+using namespace std;
+
+namespace HD
+{
+/*
+ * Constructor. The number of variables is deduced from the size of the file.
+ * @param fileName name of the file
+ * @param n number of individuals
+ * @param isFloat if true, the values are stored in single precision, else in double precision
+ * @param offset number of bytes to skip at the beginning of the file (header), multiple of the size of a value
+ */
+MappedDesign::MappedDesign(string const& fileName, int n, bool isFloat, size_t offset)
+                          : n_(n), p_(0), isFloat_(isFloat)
+                          , elementSize_(isFloat ? sizeof(float) : sizeof(double))
+                          , p_map_(0), mapSize_(0), p_data_(0)
+#ifdef _WIN32
+                          , hFile_(0), hMapping_(0)
+#endif
+                          , mean_()
+{
+  //the values are read in place: they must be aligned
+  if(offset % elementSize_ != 0)
+    throw STK::runtime_error(STK::String("The offset of the file ") + fileName + STK::String(" is not a multiple of the size of a value."));
+  map(fileName);
+  size_t colSize = (size_t) n_ * elementSize_;
+  size_t dataSize = (mapSize_ > offset) ? mapSize_ - offset : 0;
+  if(n_ <= 0 || dataSize == 0 || dataSize % colSize != 0)
+  {
+    unmap();
+    throw STK::runtime_error(STK::String("The size of the file ") + fileName + STK::String(" is not a multiple of the size of a column."));
+  }
+  p_ = dataSize / colSize;
+  p_data_ = static_cast<char const*>(p_map_) + offset;
+  mean_.resize(p_+1, 0.);
+  computeMean();
+}
+
+/* destructor*/
+MappedDesign::~MappedDesign() { unmap();}
+
+/* map the file in memory*/
+void MappedDesign::map(string const& fileName)
+{
+#ifdef _WIN32
+  hFile_ = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if(hFile_ == INVALID_HANDLE_VALUE)
+  {
+    hFile_ = 0;
+    throw STK::runtime_error(STK::String("Cannot open the file ") + fileName);
+  }
+  LARGE_INTEGER size;
+  GetFileSizeEx(hFile_, &size);
+  mapSize_ = (size_t) size.QuadPart;
+  hMapping_ = CreateFileMappingA(hFile_, NULL, PAGE_READONLY, 0, 0, NULL);
+  if(hMapping_ != 0) { p_map_ = MapViewOfFile(hMapping_, FILE_MAP_READ, 0, 0, 0);}
+  if(p_map_ == 0)
+  {
+    unmap();
+    throw STK::runtime_error(STK::String("Cannot map the file ") + fileName);
+  }
+#else
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd < 0)
+    throw STK::runtime_error(STK::String("Cannot open the file ") + fileName);
+  struct stat st;
+  if(fstat(fd, &st) != 0 || st.st_size == 0)
+  {
+    close(fd);
+    throw STK::runtime_error(STK::String("Cannot read the size of the file ") + fileName);
+  }
+  mapSize_ = (size_t) st.st_size;
+  void* p = mmap(0, mapSize_, PROT_READ, MAP_SHARED, fd, 0);
+  //the mapping stays valid after closing the file
+  close(fd);
+  if(p == MAP_FAILED)
+  {
+    mapSize_ = 0;
+    throw STK::runtime_error(STK::String("Cannot map the file ") + fileName);
+  }
+  p_map_ = p;
+  //the variables are read in the order of the file
+  posix_madvise(p_map_, mapSize_, POSIX_MADV_SEQUENTIAL);
+#endif
+}
+
+/* unmap the file*/
+void MappedDesign::unmap()
+{
+#ifdef _WIN32
+  if(p_map_) UnmapViewOfFile(p_map_);
+  if(hMapping_) CloseHandle(hMapping_);
+  if(hFile_) CloseHandle(hFile_);
+  hMapping_ = 0; hFile_ = 0;
+#else
+  if(p_map_) munmap(p_map_, mapSize_);
+#endif
+  p_map_ = 0; p_data_ = 0; mapSize_ = 0;
+}
+
+/*
+ * ask the system to read the columns jStart to jEnd in advance
+ * @param jStart, jEnd first and last index of the columns
+ */
+void MappedDesign::prefetch(int jStart, int jEnd) const
+{
+#ifndef _WIN32
+  if(jStart > p_) return;
+  jEnd = std::min(jEnd, p_);
+  static const size_t pageSize = sysconf(_SC_PAGESIZE);
+  size_t start = column(jStart) - static_cast<char const*>(p_map_);
+  size_t end = column(jEnd) + (size_t) n_ * elementSize_ - static_cast<char const*>(p_map_);
+  start -= start % pageSize;
+  posix_madvise(static_cast<char*>(p_map_) + start, end - start, POSIX_MADV_WILLNEED);
+#endif
+}
+
+Real MappedDesign::elt(int i, int j) const
+{
+  if(isFloat_) return reinterpret_cast<float const*>(column(j))[i-1];
+  return reinterpret_cast<double const*>(column(j))[i-1];
+}
+
+Real MappedDesign::dot(int j, CVectorX const& v) const
+{
+  Real sum = 0.;
+  if(isFloat_)
+  {
+    float const* col = reinterpret_cast<float const*>(column(j));
+    for(int i = 0, iv = v.begin(); i < n_; i++, iv++)
+      sum += col[i] * v[iv];
+  }
+  else
+  {
+    double const* col = reinterpret_cast<double const*>(column(j));
+    for(int i = 0, iv = v.begin(); i < n_; i++, iv++)
+      sum += col[i] * v[iv];
+  }
+  return sum;
+}
+
+void MappedDesign::addCol(int j, Real alpha, CVectorX &v) const
+{
+  if(isFloat_)
+  {
+    float const* col = reinterpret_cast<float const*>(column(j));
+    for(int i = 0, iv = v.begin(); i < n_; i++, iv++)
+      v[iv] += alpha * col[i];
+  }
+  else
+  {
+    double const* col = reinterpret_cast<double const*>(column(j));
+    for(int i = 0, iv = v.begin(); i < n_; i++, iv++)
+      v[iv] += alpha * col[i];
+  }
+}
+
+/*
+ * compute a = X'*v: the file is read sequentially by blocks of columns, the
+ * reading of the next block is asked to the system before computing the current one
+ */
+void MappedDesign::transposeProduct(CVectorX const& v, CVectorX &a) const
+{
+  prefetch(1, blockSize_);
+  for(int jStart = 1; jStart <= p_; jStart += blockSize_)
+  {
+    int jEnd = std::min(jStart + blockSize_ - 1, p_);
+    prefetch(jEnd + 1, jEnd + blockSize_);
+    for(int j = jStart; j <= jEnd; j++)
+      a[j] = dot(j,v);
+  }
+}
+
+/*
+ * compute A[k] = X'*V[k]: each block of columns is read once for all the vectors
+ */
+void MappedDesign::blockTransposeProduct(vector<CVectorX> const& V, vector<CVectorX> &A) const
+{
+  prefetch(1, blockSize_);
+  for(int jStart = 1; jStart <= p_; jStart += blockSize_)
+  {
+    int jEnd = std::min(jStart + blockSize_ - 1, p_);
+    prefetch(jEnd + 1, jEnd + blockSize_);
+    for(int j = jStart; j <= jEnd; j++)
+    {
+      if(isFloat_) { blockDot(reinterpret_cast<float const*>(column(j)), j, V, A);}
+      else { blockDot(reinterpret_cast<double const*>(column(j)), j, V, A);}
+    }
+  }
+}
+
+IDesign* MappedDesign::extractRows(vector<int> const& rows) const
+{
+  ArrayDesign* design = new ArrayDesign(rows.size(), p_);
+  CArrayXX& data = design->ownedData();
+  for(int j = 1; j <= p_; j++)
+    for(int i = 0; i < (int) rows.size(); i++)
+      data(i+1,j) = elt(rows[i],j);
+  return design;
+}
+
+/* compute the means of the columns*/
+void MappedDesign::computeMean()
+{
+  for(int jStart = 1; jStart <= p_; jStart += blockSize_)
+  {
+    int jEnd = std::min(jStart + blockSize_ - 1, p_);
+    prefetch(jEnd + 1, jEnd + blockSize_);
+    for(int j = jStart; j <= jEnd; j++)
+    {
+      Real sum = 0.;
+      for(int i = 1; i <= n_; i++)
+        sum += elt(i,j);
+      mean_[j] = sum/n_;
+    }
+  }
+}
+
+}//end namespace HD
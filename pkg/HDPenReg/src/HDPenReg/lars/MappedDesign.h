@@ -0,0 +1,128 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file MappedDesign.h
+ *  @brief In this file, we define the class @c MappedDesign, a design stored
+ *  in a memory-mapped binary file.
+ **/
+
+
+#ifndef MAPPEDDESIGN_H_
+#define MAPPEDDESIGN_H_
+
+namespace HD
+{
+/**
+ * Design stored by column in a binary file (n values of the first variable,
+ * then n values of the second...) in double or single precision. The file
+ * is mapped in memory and is never loaded: the pages are read by the system
+ * when they are accessed, so the file can be larger than the memory.
+ *
+ * The products X'*v are computed with transposeProduct, which reads the
+ * variables in the order of the file by blocks of columns and asks the system
+ * to read the next block in advance.
+ */
+  class MappedDesign : public IDesign
+  {
+    public:
+      /**
+       * Constructor. The number of variables is deduced from the size of the file.
+       * @param fileName name of the file
+       * @param n number of individuals
+       * @param isFloat if true, the values are stored in single precision, else in double precision
+       * @param offset number of bytes to skip at the beginning of the file (header), multiple of the size of a value
+       */
+      MappedDesign(std::string const& fileName, int n, bool isFloat = false, size_t offset = 0);
+      /** destructor*/
+      virtual ~MappedDesign();
+
+      inline virtual int sizeRows() const {return n_;}
+      inline virtual int sizeCols() const {return p_;}
+      virtual STK::Real elt(int i, int j) const;
+      virtual STK::Real dot(int j, STK::CVectorX const& v) const;
+      virtual void addCol(int j, STK::Real alpha, STK::CVectorX &v) const;
+      virtual void transposeProduct(STK::CVectorX const& v, STK::CVectorX &a) const;
+      /** the file is read once for all the vectors*/
+      virtual void blockTransposeProduct(std::vector<STK::CVectorX> const& V, std::vector<STK::CVectorX> &A) const;
+      inline virtual bool hasCheapColumns() const {return false;}
+      inline virtual STK::Real colMean(int j) const {return mean_[j];}
+      /** the extracted individuals are loaded in memory in a @c ArrayDesign*/
+      virtual IDesign* extractRows(std::vector<int> const& rows) const;
+
+    private:
+      /** no copy*/
+      MappedDesign(MappedDesign const&);
+      MappedDesign& operator=(MappedDesign const&);
+      /** map the file in memory, throw a STK::runtime_error if it fails*/
+      void map(std::string const& fileName);
+      /** unmap the file*/
+      void unmap();
+      /**
+       * ask the system to read the columns jStart to jEnd in advance
+       * @param jStart, jEnd first and last index of the columns
+       */
+      void prefetch(int jStart, int jEnd) const;
+      /** compute the means of the columns*/
+      void computeMean();
+      /**
+       * @param j index of the variable
+       * @return address of the j-th variable in the mapped file
+       */
+      inline char const* column(int j) const
+      { return p_data_ + (size_t) (j-1) * n_ * elementSize_;}
+
+      ///number of columns read between two calls to prefetch
+      static const int blockSize_ = 64;
+      ///number of individuals
+      int n_;
+      ///number of variables
+      int p_;
+      ///true if the values are stored in single precision
+      bool isFloat_;
+      ///size (in bytes) of a value
+      size_t elementSize_;
+      ///address of the mapping
+      void* p_map_;
+      ///size of the mapping
+      size_t mapSize_;
+      ///address of the first value
+      char const* p_data_;
+#ifdef _WIN32
+      ///handle of the file
+      void* hFile_;
+      ///handle of the mapping
+      void* hMapping_;
+#endif
+      ///mean of the columns (index from 1)
+      std::vector<STK::Real> mean_;
+  };
+}//end namespace HD
+
+#endif /* MAPPEDDESIGN_H_ */
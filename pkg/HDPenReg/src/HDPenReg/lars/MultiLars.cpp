@@ -0,0 +1,133 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file MultiLars.cpp
+ *  @brief In this file, methods associates to @c MultiLars.
+ **/
+
+#include "../larsRmain.h"
+
+using namespace STK;
+using namespace std;
+
+namespace HD
+{
+/*
+ * Constructor
+ * @param X design, a row=a individual
+ * @param Y responses, a column=a response
+ * @param maxSteps number of maximum step to do for each response
+ * @param intercept if true there is an intercept in the model
+ * @param eps epsilon (for 0)
+ */
+MultiLars::MultiLars(IDesign const& X, CArrayXX const& Y, int maxSteps, bool intercept, Real eps)
+                    : p_X_(&X), lars_(Y.sizeCols(), (Lars*) 0)
+{
+#ifdef LARS_DEBUG
+  stk_cerr << _T("Entering MultiLars::MultiLars")<<endl;
+#endif
+  int n = X.sizeRows(), p = X.sizeCols(), m = Y.sizeCols();
+  //X is centered implicitly with the same means for all the responses
+  CVectorX muX(Range(1,p), 0.);
+  if(intercept)
+  { for(int j = 1; j <= p; j++) { muX[j] = X.colMean(j);}}
+
+  //the correlations of all the responses are computed with a single pass over X
+  vector<CVectorX> y(m, CVectorX(Range(1,n))), yc(m, CVectorX(Range(1,n))), xty(m, CVectorX(Range(1,p)));
+  for(int k = 0; k < m; k++)
+  {
+    for(int i = 1, iY = Y.beginRows(); i <= n; i++, iY++)
+      y[k][i] = Y(iY, Y.beginCols()+k);
+    yc[k] = y[k];
+    if(intercept) { yc[k] -= y[k].mean();}
+  }
+  p_X_->blockTransposeProduct(yc,xty);
+  for(int k = 0; k < m; k++)
+  {
+    Real sumY = yc[k].sum();
+    for(int j = 1; j <= p; j++)
+      xty[k][j] -= muX[j] * sumY;
+    lars_[k] = new Lars(X, y[k], muX, xty[k], maxSteps, intercept, eps);
+  }
+#ifdef LARS_DEBUG
+  stk_cerr << _T("MultiLars::MultiLars done")<<endl;
+#endif
+}
+
+/* destructor*/
+MultiLars::~MultiLars()
+{
+  for(int k = 0; k < (int) lars_.size(); k++)
+    delete lars_[k];
+}
+
+/* run the lars algorithm for all the responses*/
+void MultiLars::run()
+{
+#ifdef LARS_DEBUG
+  stk_cerr << _T("Entering MultiLars::run")<<endl;
+#endif
+  vector<int> running, next, batch;
+  for(int k = 0; k < (int) lars_.size(); k++)
+  { if(lars_[k]->start()) running.push_back(k);}
+
+  vector<CVectorX> u, a;
+  while(!running.empty())
+  {
+    //the steps of the paths still running are done together: the paths needing X'u
+    //are batched in a single product
+    next.clear();
+    batch.clear();
+    for(vector<int>::iterator it = running.begin(); it != running.end(); it++)
+    {
+      Lars& lars = *lars_[*it];
+      if(!lars.beginStep()) continue;
+      next.push_back(*it);
+      if(lars.needProduct()) { batch.push_back(*it);}
+      else { lars.endStep();}
+    }
+    if(!batch.empty())
+    {
+      u.resize(batch.size());
+      a.resize(batch.size(), CVectorX(Range(1,p_X_->sizeCols())));
+      for(int b = 0; b < (int) batch.size(); b++)
+        u[b] = lars_[batch[b]]->equiangular();
+      p_X_->blockTransposeProduct(u,a);
+      for(int b = 0; b < (int) batch.size(); b++)
+        lars_[batch[b]]->endStep(&a[b]);
+    }
+    running.swap(next);
+  }
+#ifdef LARS_DEBUG
+  stk_cerr << _T("MultiLars::run done")<<endl;
+#endif
+}
+
+}//end namespace HD
@@ -0,0 +1,97 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file MultiLars.h
+ *  @brief In this file, we define the class @c MultiLars.
+ **/
+
+
+#ifndef MULTILARS_H_
+#define MULTILARS_H_
+
+namespace HD
+{
+/**
+ * Class for running the LARS algorithm on several responses sharing the same design.
+ *
+ * The means of the variables are computed once and the correlations X'Y of all the
+ * responses are computed in a single pass over X. The paths are then run step by step
+ * together: at each step, the products X'u of the equiangular vectors of all the paths
+ * still running are computed in a single pass over X (see IDesign::blockTransposeProduct).
+ * A path which stops leaves the others running.
+ */
+  class MultiLars
+  {
+    public:
+      /**
+       * Constructor
+       * @param X design, a row=a individual. X is not copied and must exist as long as the object
+       * @param Y responses, a column=a response
+       * @param maxSteps number of maximum step to do for each response
+       * @param intercept if true there is an intercept in the model
+       * @param eps epsilon (for 0)
+       */
+      MultiLars( IDesign const& X
+               , STK::CArrayXX const& Y
+               , int maxSteps
+               , bool intercept=true
+               , STK::Real eps =STK::Arithmetic<STK::Real>::epsilon());
+      /** destructor*/
+      ~MultiLars();
+
+      /**@return number of responses*/
+      inline int nbResponse() const {return lars_.size();}
+      /**
+       * @param k index of the response, between 0 and nbResponse()-1
+       * @return the lars object of the k-th response
+       */
+      inline Lars const& lars(int k) const {return *lars_[k];}
+      /**
+       * @param k index of the response, between 0 and nbResponse()-1
+       * @return the lars object of the k-th response, e.g. for setting its stopping criteria before run
+       */
+      inline Lars& lars(int k) {return *lars_[k];}
+
+      /** run the lars algorithm for all the responses*/
+      void run();
+
+    private:
+      /** no copy*/
+      MultiLars(MultiLars const&);
+      MultiLars& operator=(MultiLars const&);
+      ///pointer on the design size n*p
+      IDesign const* p_X_;
+      ///lars object of each response
+      std::vector<Lars*> lars_;
+  };
+
+}//end namespace
+
+#endif /* MULTILARS_H_ */
@@ -32,6 +32,7 @@
  *  @brief In this file, implementation of the methods of @c Path .
  **/
 
+#include <algorithm>
 #include "../larsRmain.h"
 
 using namespace STK;
@@ -42,12 +43,44 @@ namespace HD
 //Constructors
 Path::Path(int maxSizePath)
 {
-  states_.reserve(maxSizePath);
-  evolution_.reserve(maxSizePath);
-  states_.push_back(PathState());
+  stateBegin_.reserve(maxSizePath+2);
+  l1norm_.reserve(maxSizePath+1);
+  addBegin_.reserve(maxSizePath+1);
+  dropBegin_.reserve(maxSizePath+1);
+  //a step adds or drops a variable, except in case of ties
+  addIdx_.reserve(maxSizePath);
+  dropIdx_.reserve(maxSizePath);
   lambda_.reserve(maxSizePath);
+  //the first state is empty
+  stateBegin_.push_back(0);
+  stateBegin_.push_back(0);
+  l1norm_.push_back(0.);
+  addBegin_.push_back(0);
+  dropBegin_.push_back(0);
 }
 
+/*
+ * constructor from the states stored in flat arrays. The evolution is not stored.
+ * @param stateBegin offsets of the states in varIdx and varCoeff (size: number of states + 1)
+ * @param varIdx index of the active variables of all the states
+ * @param varCoeff coefficients of the active variables of all the states
+ * @param l1norm l1 norm of each state
+ * @param lambda lambda of each state, the last one can be omitted when it is 0
+ */
+Path::Path( vector<int> const& stateBegin, vector<int> const& varIdx
+          , vector<Real> const& varCoeff, vector<Real> const& l1norm
+          , vector<Real> const& lambda)
+          : stateBegin_(stateBegin)
+          , varIdx_(varIdx)
+          , varCoeff_(varCoeff)
+          , l1norm_(l1norm)
+          , addBegin_(l1norm.size(), 0)
+          , addIdx_()
+          , dropBegin_(l1norm.size(), 0)
+          , dropIdx_()
+          , lambda_(lambda)
+{}
+
   //Methods
 /* @brief Add coefficients of a LARS step to the actual path
  * @param indexVariables Array2DVector containing the index of active variables
@@ -57,10 +90,122 @@ Path::Path(int maxSizePath)
  */
 void Path::addCoeff(VectorXi const& indexVariables,VectorX const& coefficients,int idxVarAdd,int idxVarDrop)
 {
-  states_.push_back(PathState());
-  states_.back().update(indexVariables,coefficients);
-  vector<int> idxVarAddVect(1,idxVarAdd), idxVarDropVect(1,idxVarDrop);
-  evolution_.push_back(make_pair(idxVarAddVect,idxVarDropVect));
+  Real l1norm = 0.;
+  for(int i = coefficients.begin(); i < coefficients.end(); i++)
+  {
+    varIdx_.push_back(indexVariables[i]);
+    varCoeff_.push_back(coefficients[i]);
+    l1norm += std::abs(coefficients[i]);
+  }
+  stateBegin_.push_back(varIdx_.size());
+  l1norm_.push_back(l1norm);
+  pushEvolution(vector<int>(1,idxVarAdd), vector<int>(1,idxVarDrop));
+}
+
+/* copy the states in flat arrays
+ * @param stateBegin array of size size()+1
+ * @param varIdx array of size nbCoefficients()
+ * @param varCoeff array of size nbCoefficients()
+ * @param l1norm array of size size()
+ */
+void Path::copyStates(int* stateBegin, int* varIdx, Real* varCoeff, Real* l1norm) const
+{
+  std::copy(stateBegin_.begin(), stateBegin_.end(), stateBegin);
+  std::copy(varIdx_.begin(), varIdx_.end(), varIdx);
+  std::copy(varCoeff_.begin(), varCoeff_.end(), varCoeff);
+  std::copy(l1norm_.begin(), l1norm_.end(), l1norm);
+}
+
+/* copy the add and drop events in flat arrays
+ * @param addBegin, dropBegin arrays of size size()
+ * @param addIdx array of size nbAddEvents()
+ * @param dropIdx array of size nbDropEvents()
+ */
+void Path::copyEvolution(int* addBegin, int* addIdx, int* dropBegin, int* dropIdx) const
+{
+  std::copy(addBegin_.begin(), addBegin_.end(), addBegin);
+  std::copy(addIdx_.begin(), addIdx_.end(), addIdx);
+  std::copy(dropBegin_.begin(), dropBegin_.end(), dropBegin);
+  std::copy(dropIdx_.begin(), dropIdx_.end(), dropIdx);
+}
+
+/* @return evolution of the path: for each step, the index of the add and drop variables*/
+vector< pair<vector<int> ,vector<int> > > Path::evolution() const
+{
+  vector< pair<vector<int> ,vector<int> > > evolution;
+  evolution.reserve(addBegin_.size()-1);
+  for(int i = 0; i < (int) addBegin_.size()-1; i++)
+    evolution.push_back(this->evolution(i));
+  return evolution;
+}
+
+/*
+ * compute the coefficients at several points of the path, as the columns of a CSC matrix
+ * @param index l1norm or lambda values of the points, in any order
+ * @param lambdaMode if true, index contains lambda values (the lambda of the last state is 0 if it is not stored)
+ * @param colBegin offsets of the columns in rowIdx and values (size: index.size()+1, 0-based)
+ * @param rowIdx index of the variables, increasing in each column
+ * @param values coefficients
+ */
+void Path::coefficients( vector<Real> const& index, bool lambdaMode
+                       , vector<int>& colBegin, vector<int>& rowIdx, vector<Real>& values) const
+{
+  int nbIndex = index.size(), lastState = size()-1;
+  //abscissa of the states, non decreasing along the path: the l1norm or -lambda
+  vector<Real> abscissa(l1norm_);
+  if(lambdaMode)
+  {
+    //the lambda of the last state is stored only if the path has been truncated
+    abscissa[lastState] = 0.;
+    for(int i = 0; i < (int) lambda_.size(); i++) { abscissa[i] = -lambda_[i];}
+  }
+  //the points are sorted along the path
+  vector< pair<Real,int> > order(nbIndex);
+  for(int s = 0; s < nbIndex; s++) { order[s] = make_pair(lambdaMode ? -index[s] : index[s], s);}
+  sort(order.begin(), order.end());
+
+  //segment and weight of the state at the end of the segment of each point. state -1 for the
+  //points before the first state, their coefficients are equal to 0
+  vector<int> state(nbIndex, -1);
+  vector<Real> weight(nbIndex, 1.);
+  int k = 0;
+  for(int s = 0; s < nbIndex; s++)
+  {
+    Real x = order[s].first;
+    int idx = order[s].second;
+    if(x <= abscissa[0]) { continue;}
+    if(x >= abscissa[lastState]) { state[idx] = lastState; continue;}
+    if(k == 0) { k = lower_bound(abscissa.begin(), abscissa.end(), x) - abscissa.begin();}
+    else { while(abscissa[k] < x) { k++;}}
+    state[idx] = k;
+    weight[idx] = (x - abscissa[k-1])/(abscissa[k] - abscissa[k-1]);
+  }
+
+  colBegin.assign(1, 0);
+  rowIdx.clear();
+  values.clear();
+  vector< pair<int,Real> > coeff;
+  for(int s = 0; s < nbIndex; s++)
+  {
+    coeff.clear();
+    if(state[s] > 0)
+    {
+      int i = state[s];
+      for(int j = 1; j <= size(i-1); j++) { coeff.push_back(make_pair(varIdx(i-1,j), (1.-weight[s]) * varCoeff(i-1,j)));}
+      for(int j = 1; j <= size(i); j++) { coeff.push_back(make_pair(varIdx(i,j), weight[s] * varCoeff(i,j)));}
+      sort(coeff.begin(), coeff.end());
+    }
+    //a variable active in the two states appears twice
+    for(int j = 0; j < (int) coeff.size(); j++)
+    {
+      Real value = coeff[j].second;
+      if( (j+1 < (int) coeff.size()) && (coeff[j+1].first == coeff[j].first) ) { value += coeff[++j].second;}
+      if(value == 0.) { continue;}
+      rowIdx.push_back(coeff[j].first);
+      values.push_back(value);
+    }
+    colBegin.push_back(rowIdx.size());
+  }
 }
 
 /* @brief get coefficient associates to a l1norm value.
@@ -74,18 +219,18 @@ Array1D< pair<int,Real> > Path::coeff(Real l1norm) const
   {
     //search off the interval of m_l1norm containing l1norm
     int indexl1norm=0;
-    while( ( states_[indexl1norm].l1norm() < l1norm ) && ( indexl1norm < (int)states_.size()-1 ) )
+    while( ( l1norm_[indexl1norm] < l1norm ) && ( indexl1norm < size()-1 ) )
     { indexl1norm++;}
-    if(l1norm==states_[indexl1norm].l1norm())//if l1norm is equal to an actual l1norm
-    {  coeff=states_[indexl1norm].coefficients();}
+    if(l1norm==l1norm_[indexl1norm])//if l1norm is equal to an actual l1norm
+    {  coeff=states(indexl1norm).coefficients();}
     else
     {
-      if( indexl1norm == (int) states_.size()-1 )//last m_l1norm, we return the last coefficient
-        coeff=states_[indexl1norm].coefficients();
+      if( indexl1norm == size()-1 )//last m_l1norm, we return the last coefficient
+        coeff=states(indexl1norm).coefficients();
       else
-        coeff=computeCoefficients( states_[indexl1norm-1]
-                                 , states_[indexl1norm]
-                                 , evolution_[indexl1norm-1]
+        coeff=computeCoefficients( states(indexl1norm-1)
+                                 , states(indexl1norm)
+                                 , evolution(indexl1norm-1)
                                  , l1norm);
     }
   }
@@ -100,13 +245,8 @@ Array1D< pair<int,Real> > Path::coeff(Real l1norm) const
  */
 void Path::addCaseUpdate(Real gamma, CVectorX const& w, std::vector<int> const& addIdxVar)
 {
-  //copy the previous states
-  states_.push_back(states_.back());
-  //update of evolution with the new index
   vector<int> vide;
-  evolution_.push_back(make_pair(addIdxVar,vide));
-  //update of the coefficients
-  states_.back().addUpdate(w,gamma,addIdxVar);
+  pushState(gamma, w, addIdxVar, vide, vide);
 }
 
 /*
@@ -116,13 +256,8 @@ void Path::addCaseUpdate(Real gamma, CVectorX const& w, std::vector<int> const&
  */
 void Path::update(Real gamma, CVectorX const& w)
 {
-  //copy the previous states
-  states_.push_back(states_.back());
-  //update of evolution with the new index
   vector<int> vide;
-  evolution_.push_back(make_pair(vide,vide));
-  //update of the coefficients
-  states_.back().update(w,gamma);
+  pushState(gamma, w, vide, vide, vide);
 }
 
 /*
@@ -134,14 +269,7 @@ void Path::update(Real gamma, CVectorX const& w)
  * @param dropIdx index (in the vector of coefficients of the previous step) of the variable to delete
  */
 void Path::addWithDropCaseUpdate(Real gamma, CVectorX const& w, std::vector<int> const& addIdxVar, std::vector<int> const& dropIdxVar, std::vector<int> const& dropIdx)
-{
-  //copy the previous states
-  states_.push_back(states_.back());
-  //update of evolution with the new index
-  evolution_.push_back(make_pair(addIdxVar,dropIdxVar));
-  //update of the coefficients
-  states_.back().addWithDropUpdate(w, gamma, addIdxVar, dropIdx);
-}
+{ pushState(gamma, w, addIdxVar, dropIdxVar, dropIdx);}
 
 /*
  * update of the coefficients of the previous state with a variable to drop
@@ -152,15 +280,77 @@ void Path::addWithDropCaseUpdate(Real gamma, CVectorX const& w, std::vector<int>
  */
 void Path::dropAfterDropCaseUpdate(Real gamma, CVectorX const& w, std::vector<int> const& dropIdxVar, std::vector<int> const& dropIdx)
 {
-  //copy the previous states
-  states_.push_back(states_.back());
-  //update of evolution with the new index
   vector<int> vide;
-  evolution_.push_back(make_pair(vide,dropIdxVar));
-  //update of the coefficients
-  states_.back().dropAfterDropUpdate(w,gamma,dropIdx);
+  pushState(gamma, w, vide, dropIdxVar, dropIdx);
+}
+
+/*
+ * reserve the memory of the coefficients of all the states
+ * @param nbCoefficients number of coefficients of all the states
+ */
+void Path::reserve(int nbCoefficients)
+{
+  varIdx_.reserve(nbCoefficients);
+  varCoeff_.reserve(nbCoefficients);
+}
+
+/*
+ * add a state computed from the last state
+ * @param gamma step of the update
+ * @param w direction of the update
+ * @param addIdxVar index of the variables to add
+ * @param dropIdxVar index of the variables to delete
+ * @param dropIdx positions (in the last state, in increasing order) of the variables to delete
+ */
+void Path::pushState( Real gamma, CVectorX const& w
+                    , vector<int> const& addIdxVar
+                    , vector<int> const& dropIdxVar
+                    , vector<int> const& dropIdx)
+{
+  int begin = stateBegin_[size()-1], nbVar = size(size()-1);
+  //geometric growth: the arrays are not reallocated at each step
+  size_t newSize = varIdx_.size() + nbVar + addIdxVar.size();
+  if(newSize > varIdx_.capacity())
+  {
+    varIdx_.reserve(std::max(newSize, 2*varIdx_.capacity()));
+    varCoeff_.reserve(std::max(newSize, 2*varCoeff_.capacity()));
+  }
+  Real l1norm = 0.;
+  //update of the coefficients of the variables which are not deleted
+  vector<int>::const_iterator itDrop = dropIdx.begin();
+  for(int i = 1; i <= nbVar; i++)
+  {
+    if( (itDrop != dropIdx.end()) && (*itDrop == i) ) { ++itDrop; continue;}
+    int idx = varIdx_[begin+i-1];
+    Real coeff = varCoeff_[begin+i-1] + gamma*w[i];
+    varIdx_.push_back(idx);
+    varCoeff_.push_back(coeff);
+    l1norm += std::abs(coeff);
+  }
+  //the new variables are added at the end
+  for(int i = 0; i < (int) addIdxVar.size(); i++)
+  {
+    Real coeff = gamma*w[nbVar+1+i];
+    varIdx_.push_back(addIdxVar[i]);
+    varCoeff_.push_back(coeff);
+    l1norm += std::abs(coeff);
+  }
+  stateBegin_.push_back(varIdx_.size());
+  l1norm_.push_back(l1norm);
+  pushEvolution(addIdxVar, dropIdxVar);
 }
 
+/* add the events of a step
+ * @param addIdxVar index of the add variables
+ * @param dropIdxVar index of the drop variables
+ */
+void Path::pushEvolution(vector<int> const& addIdxVar, vector<int> const& dropIdxVar)
+{
+  addIdx_.insert(addIdx_.end(), addIdxVar.begin(), addIdxVar.end());
+  addBegin_.push_back(addIdx_.size());
+  dropIdx_.insert(dropIdx_.end(), dropIdxVar.begin(), dropIdxVar.end());
+  dropBegin_.push_back(dropIdx_.size());
+}
 
 /*
  * add an element at the end of the vector of the correlation max
@@ -41,177 +41,37 @@ namespace HD
 {
   //constructors
 /* default constructor*/
-PathState::PathState(): coefficients_(Range(1,0)), l1norm_(0.) {}
+PathState::PathState(): p_idx_(0), p_coeff_(0), size_(0), l1norm_(0.) {}
 
 /*
- * constructor with reserve size
- * @param nbMaxVariable maximal number of variable to potentially stock
+ * constructor of a view
+ * @param p_idx pointer on the index of the active variables
+ * @param p_coeff pointer on the coefficients of the active variables
+ * @param size number of active variables
+ * @param l1norm l1 norm of the coefficients
  */
-PathState::PathState(int nbMaxVariable): coefficients_(Range(1,0)), l1norm_(0.)
-{
-  coefficients_.reserve(nbMaxVariable);
-  coefficients_.shift(1); // in case
-}
+PathState::PathState(int const* p_idx, Real const* p_coeff, int size, Real l1norm)
+                    : p_idx_(p_idx), p_coeff_(p_coeff), size_(size), l1norm_(l1norm)
+{}
 
-/* update coefficients with values specified in parameters
- * @param indexVariables vector containing the index of active variables
- * @param coefficients vector containing the value of estimates for active variables
- */
-void PathState::update(VectorXi const& indexVariables, VectorX const& coefficients)
+/* @return a copy of the coefficients in a vector of pair(index,coefficient)*/
+Array1D< pair<int,Real> > PathState::coefficients() const
 {
-  //resize the container
-  coefficients_.resize(coefficients.range());
-  l1norm_=0;
-  //fill the container and compute l1norm
-  for(int i=coefficients_.begin(); i<coefficients_.end(); i++)
-  {
-    coefficients_[i]=make_pair(indexVariables[i], coefficients[i]);
-    l1norm_ += std::abs(coefficients[i]);
-  }
+  Array1D< pair<int,Real> > coefficients(Range(1,size_));
+  for(int i = 1; i <= size_; i++)
+    coefficients[i] = make_pair(p_idx_[i-1], p_coeff_[i-1]);
+  return coefficients;
 }
 
 /*print coefficients*/
 void PathState::printCoeff() const
 {
-  for(int i=coefficients_.begin(); i<coefficients_.end(); i++)
-    std::cout << coefficients_[i].first<<"        ";
+  for(int i = 0; i < size_; i++)
+    std::cout << p_idx_[i]<<"        ";
   std::cout<<std::endl;
-  for(int i=coefficients_.begin(); i<coefficients_.end(); i++)
-    std::cout << coefficients_[i].second<<" ";
+  for(int i = 0; i < size_; i++)
+    std::cout << p_coeff_[i]<<" ";
   std::cout<<std::endl;
 }
 
-/*
- * update of the coefficients of the previous step
- * @param w direction of the update
- * @param gamma step of the update
- */
-void PathState::update(CVectorX const& w, Real gamma)
-{
-  l1norm_=0;
-  for(int i=coefficients_.begin(); i<coefficients_.end(); i++)
-  {
-    coefficients_[i].second += gamma*w[i];
-    l1norm_ += std::abs(coefficients_[i].second);
-  }
-}
-
-/*
- * update of the coefficients of the previous state with a variable to drop and a variable to add
- * @param w direction of the update
- * @param gamma step of the update
- * @param addIdxVar index of the variable to add
- * @param dropIdx index (in the vector of coefficients of the previous step) of the variable to delete
- */
-void PathState::addWithDropUpdate(CVectorX const& w, Real gamma, vector<int> const& addIdxVar, vector<int> const& dropIdx)
-{
-  //update the other variable
-  l1norm_=0;
-//  if(dropIdx[0]!=1)
-//  {
-    for(int i=coefficients_.begin(); i < dropIdx[0]; i++)
-    {
-      coefficients_[i].second += gamma*w[i];
-      l1norm_ += std::abs(coefficients_[i].second);
-    }
-//  }
-  if(dropIdx.size() > 1)
-  {
-    for(int j = 0; j < (int) dropIdx.size(); j++)
-    {
-      for(int i = dropIdx[j]+1; i < dropIdx[j]; i++)
-      {
-        coefficients_[i].second += gamma*w[i];
-        l1norm_ += std::abs(coefficients_[i].second);
-      }
-    }
-  }
-  if(dropIdx.back()!=coefficients_.lastIdx())
-  {
-    for(int i=dropIdx.back()+1; i < coefficients_.end(); i++)
-    {
-      coefficients_[i].second += gamma*w[i];
-      l1norm_ += std::abs(coefficients_[i].second);
-    }
-  }
-  //add the new variable
-  for(int i = 0; i < (int) addIdxVar.size(); i++)
-  {
-    coefficients_.pushBack(1);
-    coefficients_.back()=make_pair(addIdxVar[i],gamma*w[coefficients_.lastIdx()]);
-    l1norm_ += std::abs(coefficients_.back().second);
-  }
-  //delete the variable to delete
-  for(int i = dropIdx.size()-1; i >= 0; i--)
-    coefficients_.erase(dropIdx[i]);
-}
-
-/*
- * update of the coefficients of the previous state with a variable to drop
- * @param w direction of the update
- * @param gamma step of the update
- * @param dropIdx index (in the vector of coefficients of the previous step) of the variable to delete
- */
-void PathState::dropAfterDropUpdate(CVectorX const& w, Real gamma, vector<int> const& dropIdx)
-{
-  l1norm_=0;
-  //update the other coefficient
-  if(dropIdx[0]!=1)
-  {
-    for(int i = coefficients_.begin(); i < dropIdx[0]; i++)
-    {
-      coefficients_[i].second += gamma*w[i];
-      l1norm_ += std::abs(coefficients_[i].second);
-    }
-  }
-  if(dropIdx.size() > 1)
-  {
-    for(int j = 0; j < (int) dropIdx.size(); j++)
-    {
-      for(int i = dropIdx[j]+1; i < dropIdx[j]; i++)
-      {
-        coefficients_[i].second += gamma*w[i];
-        l1norm_ += std::abs(coefficients_[i].second);
-      }
-    }
-  }
-  if(dropIdx.back()!=coefficients_.lastIdx())
-  {
-    for(int i = dropIdx.back() + 1; i < coefficients_.end(); i++)
-    {
-      coefficients_[i].second += gamma*w[i];
-      l1norm_ += std::abs(coefficients_[i].second);
-    }
-  }
-  //delete the variables to delete
-  for(int i = dropIdx.size()-1; i >= 0; i--)
-    coefficients_.erase(dropIdx[i]);
-}
-
-/*
- * update of the coefficients of the previous state with a new variable
- * @param w direction of the update
- * @param gamma step of the update
- * @param addIdxVar index of the variable to add
- */
-void PathState::addUpdate(CVectorX const& w, Real gamma, vector<int> const& addIdxVar)
-{
-  //update previous coefficients
-  l1norm_=0;
-  for(int i=coefficients_.begin(); i<coefficients_.end(); i++)
-  {
-    coefficients_[i].second += gamma * w[i];
-    l1norm_ += std::abs(coefficients_[i].second);
-  }
-  for(int i = 0; i < (int) addIdxVar.size(); i++)
-  {
-    coefficients_.pushBack(1);
-    coefficients_.back() = make_pair(addIdxVar[i], gamma * w[coefficients_.lastIdx()]);
-    l1norm_ += std::abs(coefficients_.back().second);
-  }
-}
-
 }//end namespace
-
-
-
@@ -41,92 +41,50 @@ namespace HD
 /**
  * This class defines the solution of the lars algorithm at a fixed step.
  * It contains the index and coefficients of active variables and the l1norm of the coefficients.
+ * A PathState is a view on the arrays of a @c Path: it does not own its data and it is invalidated
+ * when the path grows.
  */
   class PathState
   {
     public:
       //constructors
-      /** default constructor*/
+      /** default constructor: empty state*/
       PathState();
 
       /**
-       * constructor with reserve size
-       * @param nbMaxVariable maximal number of variable to potentially stock
+       * constructor of a view
+       * @param p_idx pointer on the index of the active variables
+       * @param p_coeff pointer on the coefficients of the active variables
+       * @param size number of active variables
+       * @param l1norm l1 norm of the coefficients
        */
-      PathState(int nbMaxVariable);
-
-      //setters
-      /**set coefficients_ to a new value
-       * @param coefficients vector of pair(index,coefficient)
-       */
-      inline void setCoefficients(STK::Array1D< std::pair<int,STK::Real> > const& coefficients)
-      {coefficients_=coefficients;}
-
-      /**set l1norm_ to a new value
-       * @param l1norm the new l1norm of the coefficient
-       */
-      inline void setl1norm(STK::Real const& l1norm) {l1norm_=l1norm;}
+      PathState(int const* p_idx, STK::Real const* p_coeff, int size, STK::Real l1norm);
 
       //getters
       /**@return l1norm_*/
       inline STK::Real const l1norm() const {return l1norm_;}
-      /**@return coefficients_*/
-      inline STK::Array1D< std::pair<int,STK::Real> > const& coefficients() const {return coefficients_;}
-      /**@return coefficients_[i]*/
-      inline std::pair<int,STK::Real> const& coefficients(int i) const {return coefficients_[i];}
-      /**@return coefficients_[i].first*/
-      inline int  varIdx(int i) const {return coefficients_[i].first;}
-      /**@return coefficients_[i].first*/
-      inline STK::Real varCoeff(int i) const {return coefficients_[i].second;}
+      /**@return a copy of the coefficients in a vector of pair(index,coefficient)*/
+      STK::Array1D< std::pair<int,STK::Real> > coefficients() const;
+      /**@return pair(index,coefficient) of the i-th active variable*/
+      inline std::pair<int,STK::Real> coefficients(int i) const {return std::make_pair(p_idx_[i-1], p_coeff_[i-1]);}
+      /**@return index of the i-th active variable*/
+      inline int  varIdx(int i) const {return p_idx_[i-1];}
+      /**@return coefficient of the i-th active variable*/
+      inline STK::Real varCoeff(int i) const {return p_coeff_[i-1];}
       /**@return size of the vector*/
-      inline int size() const {return coefficients_.size();}
+      inline int size() const {return size_;}
 
       //methods
-      /** update coefficients with values specified in parameters
-       * @param indexVariables vector containing the index of active variables
-       * @param coefficients vector containing the value of estimates for active variables
-       */
-      void update(STK::VectorXi const& indexVariables,STK::VectorX const& coefficients);
-
-      /**
-       * update of the coefficients of the previous step
-       * @param w direction of the update
-       * @param gamma step of the update
-       */
-      void update(STK::CVectorX const& w, STK::Real gamma);
-
-      /**
-       * update of the coefficients of the previous state with a variable to drop and a variable to add
-       * @param w direction of the update
-       * @param gamma step of the update
-       * @param addIdxVar index of the variable to add
-       * @param dropIdx index (in the vector of coefficients of the previous step) of the variable to delete
-       */
-      void addWithDropUpdate(STK::CVectorX const& w, STK::Real gamma, std::vector<int> const& addIdxVar, std::vector<int> const& dropIdx);
-
-      /**
-       * update of the coefficients of the previous state with a variable to drop
-       * @param w direction of the update
-       * @param gamma step of the update
-       * @param dropIdx index (in the vector of coefficients of the previous step) of the variable to delete
-       */
-      void dropAfterDropUpdate(STK::CVectorX const& w, STK::Real gamma, std::vector<int> const& dropIdx);
-
-      /**
-       * update of the coefficients of the previous state with a new variable
-       * @param w direction of the update
-       * @param gamma step of the update
-       * @param addIdxVar index of the variable to add
-       */
-      void addUpdate(STK::CVectorX const& w, STK::Real gamma, std::vector<int> const& addIdxVar);
-
       /**print coefficients*/
       void printCoeff() const;
 
-
     private:
-      ///vector of pair (index, coefficient) containing the active variables
-      STK::Array1D< std::pair<int,STK::Real> > coefficients_;
+      ///index of the active variables
+      int const* p_idx_;
+      ///coefficients of the active variables
+      STK::Real const* p_coeff_;
+      ///number of active variables
+      int size_;
       ///l1 norm of the coefficients
       STK::Real l1norm_;
   };
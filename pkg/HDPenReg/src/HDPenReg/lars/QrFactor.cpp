@@ -0,0 +1,163 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file QrFactor.cpp
+ *  @brief Code of methods associates to @c QrFactor.
+ **/
+
+#include <cmath>
+#include <algorithm>
+#include "../larsRmain.h"
+
+using namespace STK;
+using namespace std;
+
+namespace HD
+{
+/* default constructor: empty factor*/
+QrFactor::QrFactor() : n_(0), q_(), r_(), proj_(), size_(0)
+{}
+
+/* reserve the memory for kMax columns of size n*/
+void QrFactor::reserve(int n, int kMax)
+{
+  n_ = n;
+  q_.reserve((size_t) n * kMax);
+  r_.reserve(offset(kMax));
+  proj_.reserve(kMax);
+}
+
+/* remove all the columns*/
+void QrFactor::clear()
+{
+  q_.clear();
+  r_.clear();
+  size_ = 0;
+}
+
+/*
+ * add a column to Xi
+ * @param x the new column
+ * @param eps threshold of colinearity
+ * @return false if x is colinear with the columns of Xi
+ */
+bool QrFactor::pushBackCol(CVectorX const& x, Real eps)
+{
+  int k = size_;
+  if(k == 0) { n_ = x.size();}
+  //no allocation if the memory has been reserved
+  q_.resize((size_t) n_ * (k+1));
+  r_.resize(offset(k+1));
+  proj_.resize(k);
+  Real* qk = &q_[(size_t) n_ * k];
+  Real* col = &r_[offset(k)];
+  for(int l = 0, ix = x.begin(); l < n_; l++, ix++)
+    qk[l] = x[ix];
+  //classical Gram-Schmidt, the second pass removes the part of x left by the rounding errors of the first one
+  for(int i = 0; i < k; i++) { col[i] = 0.;}
+  for(int pass = 0; pass < 2; pass++)
+  {
+    for(int i = 0; i < k; i++)
+    {
+      Real const* qi = &q_[(size_t) n_ * i];
+      Real sum = 0.;
+      for(int l = 0; l < n_; l++)
+        sum += qi[l] * qk[l];
+      proj_[i] = sum;
+    }
+    for(int i = 0; i < k; i++)
+    {
+      Real const* qi = &q_[(size_t) n_ * i];
+      for(int l = 0; l < n_; l++)
+        qk[l] -= proj_[i] * qi[l];
+      col[i] += proj_[i];
+    }
+  }
+  Real norm2 = 0.;
+  for(int l = 0; l < n_; l++)
+    norm2 += qk[l] * qk[l];
+  Real diag = sqrt(norm2);
+  if(diag < eps)
+  {
+    q_.resize((size_t) n_ * k);
+    r_.resize(offset(k));
+    return false;
+  }
+  for(int l = 0; l < n_; l++)
+    qk[l] /= diag;
+  col[k] = diag;
+  size_++;
+  return true;
+}
+
+/*
+ * remove the column j of Xi
+ * @param j index of the column to remove
+ */
+void QrFactor::eraseCol(int j)
+{
+  //as in Cholesky::eraseCol, the element (c+1,c) of the column c (0-based) after j is removed with
+  //a rotation of the rows c and c+1 of R. Q*R is unchanged if the columns c and c+1 of Q are rotated too
+  for(int c = j-1; c < size_-1; c++)
+  {
+    Real* col = &r_[offset(c+1)];
+    Real a = col[c], b = col[c+1];
+    Real r = sqrt(a*a + b*b);
+    if(r > 0.)
+    {
+      Real cosG = a/r, sinG = b/r;
+      col[c] = r;
+      for(int l = c+2; l < size_; l++)
+      {
+        Real* colL = &r_[offset(l)];
+        Real x = colL[c], y = colL[c+1];
+        colL[c]   =  cosG * x + sinG * y;
+        colL[c+1] = -sinG * x + cosG * y;
+      }
+      Real* qc = &q_[(size_t) n_ * c];
+      Real* qc1 = &q_[(size_t) n_ * (c+1)];
+      for(int l = 0; l < n_; l++)
+      {
+        Real x = qc[l], y = qc1[l];
+        qc[l]  =  cosG * x + sinG * y;
+        qc1[l] = -sinG * x + cosG * y;
+      }
+    }
+  }
+  //the column c+1 (c+1 first rows) of R is moved at the place of the column c. The last column of Q
+  //is orthogonal to the remaining columns of Xi and is removed
+  for(int c = j-1; c < size_-1; c++)
+    std::copy(r_.begin() + offset(c+1), r_.begin() + offset(c+1) + (c+1), r_.begin() + offset(c));
+  size_--;
+  r_.resize(offset(size_));
+  q_.resize((size_t) n_ * size_);
+}
+
+}//end namespace HD
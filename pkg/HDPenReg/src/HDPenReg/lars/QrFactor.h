@@ -0,0 +1,109 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file QrFactor.h
+ *  @brief In this file, we define the class @c QrFactor.
+ **/
+
+
+#ifndef QRFACTOR_H_
+#define QRFACTOR_H_
+
+namespace HD
+{
+/**
+ * QR decomposition Xi = QR of the (centered) active variables of the lars algorithm.
+ *
+ * A column is added with two passes of Gram-Schmidt against the columns of Q and
+ * removed with Givens rotations, applied to the rows of R and to the columns of Q.
+ * Q (n x k) and the upper triangle of R are stored in contiguous arrays: once
+ * reserve has been called, adding or removing a column does not allocate memory.
+ * Rows and columns of R are indexed from 1, as in @c Cholesky.
+ */
+  class QrFactor
+  {
+    public:
+      /** default constructor: empty factor*/
+      QrFactor();
+
+      /** @return the number of columns of the factor*/
+      inline int size() const {return size_;}
+      /**
+       * @param i index of the row
+       * @param j index of the column, i <= j
+       * @return the element (i,j) of R
+       */
+      inline STK::Real operator()(int i, int j) const {return r_[offset(j-1) + i-1];}
+
+      /**
+       * reserve the memory for kMax columns of size n: n*kMax reals for Q and kMax(kMax+1)/2 for R
+       * @param n size of the columns
+       * @param kMax maximal number of columns
+       */
+      void reserve(int n, int kMax);
+      /** remove all the columns*/
+      void clear();
+      /**
+       * add a column to Xi. The diagonal element of R is the norm of the part of x orthogonal
+       * to the columns of Q: the column is not added if it is lower than eps.
+       * @param x the new column, of size n
+       * @param eps threshold of colinearity
+       * @return false if x is colinear with the columns of Xi
+       */
+      bool pushBackCol(STK::CVectorX const& x, STK::Real eps);
+      /**
+       * remove the column j of Xi. The columns of R after j are made upper triangular
+       * again with Givens rotations on the rows, the same rotations are applied to Q.
+       * @param j index of the column to remove
+       */
+      void eraseCol(int j);
+
+    private:
+      /**
+       * @param c index of a column, from 0
+       * @return position of the first element of the column c in r_
+       */
+      inline static size_t offset(int c) {return (size_t) c * (c+1) / 2;}
+
+      /// size of the columns
+      int n_;
+      /// columns of Q one after the other
+      std::vector<STK::Real> q_;
+      /// columns of R one after the other, the column j contains the rows 1 to j
+      std::vector<STK::Real> r_;
+      /// projections of the new column on Q during the second pass of Gram-Schmidt
+      std::vector<STK::Real> proj_;
+      /// number of columns
+      int size_;
+  };
+
+}//end namespace
+
+#endif /* QRFACTOR_H_ */
@@ -0,0 +1,86 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file Timings.cpp
+ *  @brief Code of methods associates to @c Timings.
+ **/
+
+#include <chrono>
+#include "../larsRmain.h"
+
+using namespace STK;
+using namespace std;
+
+namespace HD
+{
+/* default constructor: all the timings are 0*/
+Timings::Timings()
+{ reset();}
+
+/* set all the timings and counters to 0*/
+void Timings::reset()
+{
+  for(int i = 0; i < nbPhase; i++) { time_[i] = 0.; calls_[i] = 0.;}
+  nbAdd_ = 0; nbDrop_ = 0; nbIgnore_ = 0;
+}
+
+/*
+ * add the timings and counters of an other object
+ * @param timings timings to add
+ */
+Timings& Timings::operator+=(Timings const& timings)
+{
+  for(int i = 0; i < nbPhase; i++)
+  {
+    time_[i] += timings.time_[i];
+    calls_[i] += timings.calls_[i];
+  }
+  nbAdd_ += timings.nbAdd_;
+  nbDrop_ += timings.nbDrop_;
+  nbIgnore_ += timings.nbIgnore_;
+  return *this;
+}
+
+/* @return a time in seconds, from a steady clock*/
+double Timings::clock()
+{ return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();}
+
+/*
+ * @param phase a phase
+ * @return the name of the phase
+ */
+char const* Timings::name(Phase phase)
+{
+  static char const* names[nbPhase] = { "initialization", "addSet", "factorization", "gi1", "product"
+                                      , "gamma", "correlation", "path", "predict"};
+  return names[phase];
+}
+
+}//end namespace HD
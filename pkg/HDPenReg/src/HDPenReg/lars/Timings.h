@@ -0,0 +1,147 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2013-2013  Serge Iovleff, Quentin Grimonprez
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : quentin.grimonprez@inria.fr
+*/
+
+/*
+ * Project:  MPAGenomics::
+ * created on: 16 oct. 2026
+ * Author:   Quentin Grimonprez
+ **/
+
+/** @file Timings.h
+ *  @brief In this file, we define the class @c Timings.
+ **/
+
+
+#ifndef TIMINGS_H_
+#define TIMINGS_H_
+
+namespace HD
+{
+/**
+ * Cumulative wall time and number of calls of each phase of the lars algorithm,
+ * and number of added, dropped and ignored variables.
+ *
+ * A phase is timed with a @c Timer created at its beginning: the time is added
+ * when the timer is destroyed. The cost is two reads of a steady clock by phase,
+ * so the timings are always collected.
+ */
+  class Timings
+  {
+    public:
+      /** phases of the algorithm*/
+      enum Phase
+      {
+        initialization = 0, ///< means of the variables, X'y and Gram matrix
+        addSet,             ///< correlation max and variables to add of the first step
+        factorization,      ///< update of the QR decomposition or of the Cholesky factor
+        gi1,                ///< resolution of inv(Xi'Xi)*1
+        product,            ///< equiangular vector u and X'u
+        gamma,              ///< gamma hat and gamma tilde
+        correlation,        ///< update of the correlations and variables to add of the next step
+        path,               ///< update of the coefficients of the path and of the rss
+        predict,            ///< predictions from the path
+        nbPhase
+      };
+
+      /**
+       * Time a phase from the construction to the destruction of the object
+       */
+      class Timer
+      {
+        public:
+          /**
+           * Constructor: start the timer
+           * @param timings object receiving the time
+           * @param phase timed phase
+           */
+          Timer(Timings& timings, Phase phase) : timings_(timings), phase_(phase), start_(Timings::clock()) {}
+          /** destructor: add the elapsed time to the phase*/
+          ~Timer() { timings_.add(phase_, Timings::clock() - start_);}
+        private:
+          ///object receiving the time
+          Timings& timings_;
+          ///timed phase
+          Phase phase_;
+          ///time at the construction
+          double start_;
+      };
+
+      /** default constructor: all the timings are 0*/
+      Timings();
+
+      /** set all the timings and counters to 0*/
+      void reset();
+      /**
+       * add a call of a phase
+       * @param phase the phase
+       * @param seconds duration of the call
+       */
+      inline void add(Phase phase, double seconds) { time_[phase] += seconds; calls_[phase]++;}
+      /**
+       * add the timings and counters of an other object (several folds for example)
+       * @param timings timings to add
+       */
+      Timings& operator+=(Timings const& timings);
+
+      /** @return a time in seconds, from a steady clock*/
+      static double clock();
+      /**
+       * @param phase a phase
+       * @return the name of the phase
+       */
+      static char const* name(Phase phase);
+
+      /**@return cumulative time (in seconds) of a phase*/
+      inline double time(Phase phase) const {return time_[phase];}
+      /**@return number of calls of a phase*/
+      inline double calls(Phase phase) const {return calls_[phase];}
+      /**@return number of added variables*/
+      inline int nbAdd() const {return nbAdd_;}
+      /**@return number of dropped variables*/
+      inline int nbDrop() const {return nbDrop_;}
+      /**@return number of variables ignored for colinearity*/
+      inline int nbIgnore() const {return nbIgnore_;}
+
+      /** count an added variable*/
+      inline void countAdd() {nbAdd_++;}
+      /** count the dropped variables of a step*/
+      inline void countDrop(int nbDrop) {nbDrop_ += nbDrop;}
+      /** count a variable ignored for colinearity*/
+      inline void countIgnore() {nbIgnore_++;}
+
+    private:
+      ///cumulative time of each phase
+      double time_[nbPhase];
+      ///number of calls of each phase
+      double calls_[nbPhase];
+      ///number of added variables
+      int nbAdd_;
+      ///number of dropped variables
+      int nbDrop_;
+      ///number of variables ignored for colinearity
+      int nbIgnore_;
+  };
+}//end namespace HD
+
+#endif /* TIMINGS_H_ */
@@ -52,6 +52,49 @@ Real computeOrdinate(Real x1,Real x2,Real x3,Real y1,Real y2)
   return y1 + (y2-y1) * ((x3-x1)/(x2-x1)) ;
 }
 
+/* finalizer of splitmix64 */
+static unsigned long long mix64(unsigned long long z)
+{
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/*
+ * counter based random generator
+ * @param seed seed of the generator
+ * @param stream index of the stream
+ * @param counter index of the draw in the stream
+ * @return a real uniformly distributed on [0,1)
+ */
+Real uniformDraw(unsigned long seed, unsigned long stream, unsigned long counter)
+{
+  unsigned long long key = mix64(mix64((unsigned long long) seed) + 0x9E3779B97F4A7C15ULL * ((unsigned long long) stream + 1));
+  unsigned long long z = mix64(key + 0x9E3779B97F4A7C15ULL * ((unsigned long long) counter + 1));
+  //the 53 high bits give a double in [0,1)
+  return (Real) (z >> 11) * (1.0/9007199254740992.0);
+}
+
+/*
+ * random partition of n individuals in nbFolds folds
+ * @param n number of individuals
+ * @param nbFolds number of folds
+ * @param seed seed of the generator
+ * @param stream index of the stream
+ * @param partition index of the fold of each individual
+ */
+void randomPartition(int n, int nbFolds, unsigned long seed, unsigned long stream, std::vector<int>& partition)
+{
+  partition.resize(n);
+  for(int i = 0; i < n; i++) { partition[i] = i%nbFolds;}
+  //Fisher-Yates shuffle
+  for(int i = n-1; i > 0; i--)
+  {
+    int j = (int) (uniformDraw(seed, stream, i) * (i+1));
+    std::swap(partition[i], partition[j]);
+  }
+}
+
 /*
  * Compute the coefficients for a given value of l1norm
  * Use with move()
@@ -46,6 +46,27 @@
  */
 STK::Real computeOrdinate(STK::Real x1,STK::Real x2,STK::Real x3,STK::Real y1,STK::Real y2);
 
+/**
+ * Counter based random generator: the draw is a hash of (seed, stream, counter). A stream can be used
+ * by a task without any state shared with the other tasks.
+ * @param seed seed of the generator
+ * @param stream index of the stream
+ * @param counter index of the draw in the stream
+ * @return a real uniformly distributed on [0,1)
+ */
+STK::Real uniformDraw(unsigned long seed, unsigned long stream, unsigned long counter);
+
+/**
+ * random partition of n individuals in nbFolds folds of size n/nbFolds (up to one), drawn with
+ * the stream stream of the counter based generator
+ * @param n number of individuals
+ * @param nbFolds number of folds
+ * @param seed seed of the generator
+ * @param stream index of the stream
+ * @param partition index of the fold (between 0 and nbFolds-1) of each individual (will be modified)
+ */
+void randomPartition(int n, int nbFolds, unsigned long seed, unsigned long stream, std::vector<int>& partition);
+
 ///**
 // * Compute the coefficients for a given value of lambda
 // * @param state1 state of a lars step
@@ -56,71 +56,285 @@ void convertToArray(SEXP const& rMatrix, Array &output)
       output(i,j)=data(iData, jData);
 }
 
+/*
+ * create a sparse design from a dgCMatrix of the R package Matrix
+ * @param rMatrix dgCMatrix
+ * @return a pointer on the design, it must be deleted by the caller
+ */
+SparseDesign* createSparseDesign(SEXP const& rMatrix)
+{
+  Rcpp::S4 mat(rMatrix);
+  Rcpp::IntegerVector dim = mat.slot("Dim"), colPtr = mat.slot("p"), rowIdx = mat.slot("i");
+  Rcpp::NumericVector values = mat.slot("x");
+  return new SparseDesign(dim[0], dim[1], colPtr.begin(), rowIdx.begin(), values.begin());
+}
+
+/*
+ * create the design of the lars algorithm from a R matrix. A dgCMatrix is
+ * stored in a @c SparseDesign whatever the storage. With storage "double", a
+ * matrix of double is used in place (read only) without any copy.
+ * @param rMatrix R matrix of data or dgCMatrix
+ * @param n number of individuals
+ * @param p number of variables
+ * @param storage "double", "float" or "genotype"
+ * @param x container used for the data if storage is "double" and rMatrix is not a matrix of double
+ * @return a pointer on the design, it must be deleted by the caller
+ */
+IDesign* createDesign(SEXP const& rMatrix, int n, int p, std::string const& storage, STK::CArrayXX &x)
+{
+  if(Rf_inherits(rMatrix, "dgCMatrix"))
+    return createSparseDesign(rMatrix);
+  if(storage == "float")
+  {
+    STK::RMatrix<STK::Real> data(rMatrix);
+    return new FloatDesign(data);
+  }
+  if(storage == "genotype")
+  {
+    STK::RMatrix<STK::Real> data(rMatrix);
+    return new GenotypeDesign(data);
+  }
+  if(TYPEOF(rMatrix) == REALSXP)
+    return new BufferDesign(REAL(rMatrix), n, p);
+  x.resize(STK::Range(1,n), STK::Range(1,p));
+  convertToArray(rMatrix,x);
+  return new ArrayDesign(x);
+}
+
+/*
+ * set the early stopping criteria of a lars object
+ * @param lars lars object before run
+ * @param minLambda lower bound of lambda (0 for no bound)
+ * @param maxActive maximal number of active variables (0 for no limit)
+ * @param maxL1norm maximal l1 norm of the coefficients
+ */
+void setStopCriteria(Lars& lars, Real minLambda, int maxActive, Real maxL1norm)
+{
+  lars.setMinLambda(minLambda);
+  if(maxActive > 0) { lars.setMaxNbActiveVariables(maxActive);}
+  lars.setMaxL1norm(maxL1norm);
+}
+
+/*
+ * compute the maximal absolute difference between the coefficients of two paths
+ * on their common steps
+ * @param lars1, lars2 the two paths
+ * @param p number of variables
+ */
+Real maxCoefficientDeviation(Lars const& lars1, Lars const& lars2, int p)
+{
+  Real deviation = 0.;
+  STK::CVectorX diff(STK::Range(1,p));
+  int step = std::min(lars1.step(), lars2.step());
+  for(int i = 1; i <= step; i++)
+  {
+    diff = 0.;
+    for(int j = 1; j <= lars1.path(i).size(); j++)
+      diff[lars1.varIdx(i,j)] += lars1.coefficient(i,j);
+    for(int j = 1; j <= lars2.path(i).size(); j++)
+      diff[lars2.varIdx(i,j)] -= lars2.coefficient(i,j);
+    deviation = std::max(deviation, diff.abs().maxElt());
+  }
+  return deviation;
+}
+
+/*
+ * copy a path in R vectors allocated once. The coefficients of all the states are
+ * stored in the flat vectors varIdx and varCoeff, the state i being in
+ * [stateBegin[i], stateBegin[i+1]) (0-based). The add and drop variables of
+ * each step are stored in the same way.
+ * @param path path of a lars or fusion object after run
+ */
+List wrapPath(Path const& path)
+{
+  IntegerVector stateBegin(path.size()+1), varIdx(path.nbCoefficients());
+  NumericVector varCoeff(path.nbCoefficients()), l1norm(path.size());
+  IntegerVector addBegin(path.size()), addIdx(path.nbAddEvents());
+  IntegerVector dropBegin(path.size()), dropIdx(path.nbDropEvents());
+  path.copyStates(stateBegin.begin(), varIdx.begin(), varCoeff.begin(), l1norm.begin());
+  path.copyEvolution(addBegin.begin(), addIdx.begin(), dropBegin.begin(), dropIdx.begin());
+  return List::create( Named("stateBegin")=stateBegin
+                     , Named("varIdx")    =varIdx
+                     , Named("varCoeff")  =varCoeff
+                     , Named("l1norm")    =l1norm
+                     , Named("lambda")    =NumericVector(path.lambda().begin(), path.lambda().end())
+                     , Named("addBegin")  =addBegin
+                     , Named("addIdx")    =addIdx
+                     , Named("dropBegin") =dropBegin
+                     , Named("dropIdx")   =dropIdx
+                     );
+}
+
+/*
+ * convert the timings and counters of a lars, fusion or cvlars object in a R list
+ * @param timings timings after run
+ */
+List wrapTimings(Timings const& timings)
+{
+  NumericVector time(Timings::nbPhase), calls(Timings::nbPhase);
+  CharacterVector names(Timings::nbPhase);
+  for(int i = 0; i < Timings::nbPhase; i++)
+  {
+    Timings::Phase phase = static_cast<Timings::Phase>(i);
+    time[i]  = timings.time(phase);
+    calls[i] = timings.calls(phase);
+    names[i] = Timings::name(phase);
+  }
+  time.names() = names;
+  calls.names() = names;
+  IntegerVector events = IntegerVector::create( Named("add")    =timings.nbAdd()
+                                              , Named("drop")   =timings.nbDrop()
+                                              , Named("ignored")=timings.nbIgnore());
+  return List::create( Named("time")  =time
+                     , Named("calls") =calls
+                     , Named("events")=events
+                     );
+}
+
+/*
+ * convert the path of a lars object in a R list
+ * @param lars lars object after run
+ * @param deviation maximal deviation from the double precision path (empty if not computed)
+ */
+List wrapLars(Lars const& lars, vector<double> const& deviation)
+{
+  return List::create( Named("path")      =wrapPath(lars.path())
+                     , Named("step")      =wrap(lars.step())
+                     , Named("mu")        =wrap(lars.mu())
+                     , Named("ignored")   =STK::wrap(lars.toIgnore().cast<int>())
+                     , Named("error")     =wrap(lars.msg_error())
+                     , Named("muX")       =STK::wrap(lars.muX())
+                     , Named("cacheHits") =wrap(lars.cacheHits())
+                     , Named("cacheMisses")=wrap(lars.cacheMisses())
+                     , Named("rss")       =wrap(lars.rss())
+                     , Named("deviation") =wrap(deviation)
+                     , Named("timings")   =wrapTimings(lars.timings())
+                     );
+}
+
 RcppExport SEXP larsmain( SEXP data, SEXP response
                         , SEXP nbIndiv, SEXP nbVar
-                        , SEXP maxStep, SEXP intercept, SEXP eps)
+                        , SEXP maxStep, SEXP intercept, SEXP eps, SEXP gram, SEXP cacheSize, SEXP cholesky
+                        , SEXP storage, SEXP validate
+                        , SEXP minLambda, SEXP maxActive, SEXP maxL1norm)
 {
 #ifdef LARS_DEBUG
   stk_cerr << _T("Entering larsmain")<<std::endl;
 #endif
   //convert parameters
   int p = Rcpp::as<int>(nbVar), n = Rcpp::as<int>(nbIndiv), maxStepC = Rcpp::as<int>(maxStep);
-  bool interceptC = Rcpp::as<bool>(intercept);
-  STK::Real epsC  = Rcpp::as<STK::Real>(eps);
+  bool interceptC = Rcpp::as<bool>(intercept), gramC = Rcpp::as<bool>(gram), choleskyC = Rcpp::as<bool>(cholesky);
+  STK::Real epsC  = Rcpp::as<STK::Real>(eps), cacheSizeC = Rcpp::as<STK::Real>(cacheSize);
+  std::string storageC = Rcpp::as<std::string>(storage);
+  bool validateC = Rcpp::as<bool>(validate);
+  STK::Real minLambdaC = Rcpp::as<STK::Real>(minLambda), maxL1normC = Rcpp::as<STK::Real>(maxL1norm);
+  int maxActiveC = Rcpp::as<int>(maxActive);
 
-  STK::CArrayXX x(STK::Range(1,n), STK::Range(1,p));
+  STK::CArrayXX x;
   STK::CVectorX y(STK::Range(1,n));
-  convertToArray(data,x);
+  IDesign* design = createDesign(data,n,p,storageC,x);
   convertToVector(response,y);
 
 #ifdef LARS_DEBUG
   stk_cerr << _T("larsmain. Creating Lars")<<endl;
 #endif
-  Lars lars(x,y,maxStepC,interceptC,epsC);
+  Lars lars(*design,y,maxStepC,interceptC,epsC,gramC,cacheSizeC);
+  lars.setCholesky(choleskyC);
+  setStopCriteria(lars,minLambdaC,maxActiveC,maxL1normC);
   lars.run();
+  delete design;
 #ifdef LARS_DEBUG
   stk_cerr << _T("larsmain. Lars.run() done")<<endl;
 #endif
 
-  int step=lars.step();
-  vector<double> l1norm(step+1);
-  vector<vector<int> > varIdx(step+1);
-  vector<vector<double> > varCoeff(step+1);
-  vector<vector<int> > evoIdxDrop(step);
-  vector<vector<int> > evoIdxAdd(step);
-  l1norm[0]=0;
-  for(int i=1;i<=step;i++)
+  //validation of the single precision path against the double precision path
+  vector<double> deviation;
+  if(validateC && (storageC == "float") && !Rf_inherits(data, "dgCMatrix"))
   {
-    varIdx[i].resize(lars.path(i).size());
-    varCoeff[i].resize(lars.path(i).size());
-    for(int j=1;j<=lars.path(i).size();j++)
-    {
-      varCoeff[i][j-1]=lars.coefficient(i,j);
-      varIdx[i][j-1]=lars.varIdx(i,j);
-    }
-    l1norm[i]=lars.l1norm(i);
-    if(lars.evolution()[i-1].first.size()!=0)
-        evoIdxAdd[i-1]=lars.evolution()[i-1].first;
-    if(lars.evolution()[i-1].second.size()!=0)
-        evoIdxDrop[i-1]=lars.evolution()[i-1].second;
-
+    IDesign* designDouble = createDesign(data,n,p,"double",x);
+    Lars larsDouble(*designDouble,y,maxStepC,interceptC,epsC,gramC,cacheSizeC);
+    larsDouble.setCholesky(choleskyC);
+    setStopCriteria(larsDouble,minLambdaC,maxActiveC,maxL1normC);
+    larsDouble.run();
+    deviation.push_back(maxCoefficientDeviation(lars,larsDouble,p));
+    delete designDouble;
   }
+
+  List res = wrapLars(lars, deviation);
 #ifdef LARS_DEBUG
   stk_cerr << _T("larsmain done")<<std::endl;
 #endif
+  return res;
+}
 
-  return List::create( Named("l1norm")    =wrap(l1norm)
-                     , Named("lambda")    =wrap(lars.lambda())
-                     , Named("varIdx")    =wrap(varIdx)
-                     , Named("varCoeff")  =wrap(varCoeff)
-                     , Named("evoDropIdx")=wrap(evoIdxDrop)
-                     , Named("evoAddIdx") =wrap(evoIdxAdd)
-                     , Named("step")      =wrap(lars.step())
-                     , Named("mu")        =wrap(lars.mu())
-                     , Named("ignored")   =STK::wrap(lars.toIgnore().cast<int>())
-                     , Named("error")     =wrap(lars.msg_error())
-                     , Named("muX")       =STK::wrap(lars.muX())
-                     );
+RcppExport SEXP multilarsmain( SEXP data, SEXP response
+                             , SEXP nbIndiv, SEXP nbVar, SEXP nbResponse
+                             , SEXP maxStep, SEXP intercept, SEXP eps, SEXP storage
+                             , SEXP minLambda, SEXP maxActive, SEXP maxL1norm)
+{
+#ifdef LARS_DEBUG
+  stk_cerr << _T("Entering multilarsmain")<<std::endl;
+#endif
+  //convert parameters
+  int p = Rcpp::as<int>(nbVar), n = Rcpp::as<int>(nbIndiv), m = Rcpp::as<int>(nbResponse), maxStepC = Rcpp::as<int>(maxStep);
+  bool interceptC = Rcpp::as<bool>(intercept);
+  STK::Real epsC  = Rcpp::as<STK::Real>(eps);
+  std::string storageC = Rcpp::as<std::string>(storage);
+  STK::Real minLambdaC = Rcpp::as<STK::Real>(minLambda), maxL1normC = Rcpp::as<STK::Real>(maxL1norm);
+  int maxActiveC = Rcpp::as<int>(maxActive);
+
+  STK::CArrayXX x;
+  STK::CArrayXX y(STK::Range(1,n), STK::Range(1,m));
+  //the design is created once for all the responses
+  IDesign* design = createDesign(data,n,p,storageC,x);
+  convertToArray(response,y);
+
+  MultiLars multiLars(*design,y,maxStepC,interceptC,epsC);
+  for(int k = 0; k < m; k++)
+    setStopCriteria(multiLars.lars(k),minLambdaC,maxActiveC,maxL1normC);
+  multiLars.run();
+  delete design;
+
+  List res(m);
+  for(int k = 0; k < m; k++)
+    res[k] = wrapLars(multiLars.lars(k), vector<double>());
+#ifdef LARS_DEBUG
+  stk_cerr << _T("multilarsmain done")<<std::endl;
+#endif
+  return res;
+}
+
+RcppExport SEXP larsfilemain( SEXP file, SEXP response, SEXP nbIndiv, SEXP type, SEXP offset
+                            , SEXP maxStep, SEXP intercept, SEXP eps, SEXP gram, SEXP cacheSize, SEXP cholesky
+                            , SEXP minLambda, SEXP maxActive, SEXP maxL1norm)
+{
+BEGIN_RCPP
+#ifdef LARS_DEBUG
+  stk_cerr << _T("Entering larsfilemain")<<std::endl;
+#endif
+  //convert parameters
+  int n = Rcpp::as<int>(nbIndiv), maxStepC = Rcpp::as<int>(maxStep);
+  bool interceptC = Rcpp::as<bool>(intercept), gramC = Rcpp::as<bool>(gram), choleskyC = Rcpp::as<bool>(cholesky);
+  STK::Real epsC  = Rcpp::as<STK::Real>(eps), cacheSizeC = Rcpp::as<STK::Real>(cacheSize);
+  std::string fileC = Rcpp::as<std::string>(file), typeC = Rcpp::as<std::string>(type);
+  size_t offsetC = (size_t) Rcpp::as<double>(offset);
+  STK::Real minLambdaC = Rcpp::as<STK::Real>(minLambda), maxL1normC = Rcpp::as<STK::Real>(maxL1norm);
+  int maxActiveC = Rcpp::as<int>(maxActive);
+
+  STK::CVectorX y(STK::Range(1,n));
+  convertToVector(response,y);
+  //the file is mapped in memory, it is not loaded
+  MappedDesign design(fileC, n, typeC == "float", offsetC);
+
+  Lars lars(design,y,maxStepC,interceptC,epsC,gramC,cacheSizeC);
+  lars.setCholesky(choleskyC);
+  setStopCriteria(lars,minLambdaC,maxActiveC,maxL1normC);
+  lars.run();
+#ifdef LARS_DEBUG
+  stk_cerr << _T("larsfilemain done")<<std::endl;
+#endif
+  return wrapLars(lars, vector<double>());
+END_RCPP
 }
 
 RcppExport SEXP fusionmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps)
@@ -135,9 +349,16 @@ RcppExport SEXP fusionmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, S
   bool interceptC = as<bool>(intercept);
   Real epsC = as<STK::Real>(eps);
 
-  STK::CArrayXX x(STK::Range(1,n),STK::Range(1,p));
+  STK::CArrayXX x;
   STK::CVectorX y(STK::Range(1,n));
-  convertToArray(data, x);
+  SparseDesign* sparseX = 0;
+  if(Rf_inherits(data, "dgCMatrix"))
+  { sparseX = createSparseDesign(data);}
+  else
+  {
+    x.resize(STK::Range(1,n),STK::Range(1,p));
+    convertToArray(data, x);
+  }
   convertToVector(response,y);
 
   //t2=clock();
@@ -148,7 +369,10 @@ RcppExport SEXP fusionmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, S
 #ifdef FUSION_DEBUG
   stk_cerr << _T("fusionmain. Creating Fusion")<<endl;
 #endif
-  Fusion fusion(x,y,maxStepC,interceptC,epsC);
+  //with a sparse design, Z=X*L^-1 is not computed
+  Fusion* p_fusion = sparseX ? new Fusion(*sparseX,y,maxStepC,interceptC,epsC)
+                             : new Fusion(x,y,maxStepC,interceptC,epsC);
+  Fusion& fusion = *p_fusion;
   fusion.run();
 #ifdef FUSION_DEBUG
   stk_cerr << _T("fusionmain. fusion.run() done")<<endl;
@@ -158,56 +382,50 @@ RcppExport SEXP fusionmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, S
   //cout<<"Temps fusion:"<<(double) (t2-t1)/CLOCKS_PER_SEC<<"s"<<endl;
 
   //extract and convert results
-  //t1=clock();
-  int step=fusion.step();
-
-  vector<double> l1norm(step+1);
-  vector<vector<int> > varIdx(step+1);
-  vector<vector<double> > varCoeff(step+1);
-  vector<vector<int> > evoIdxDrop(step);
-  vector<vector<int> > evoIdxAdd(step);
-
-  l1norm[0]=0;
-  for(int i = 1; i <= step; i++)
-  {
-    varIdx[i].resize(fusion.path(i).size());
-    varCoeff[i].resize(fusion.path(i).size());
-    for(int j = 1; j <= fusion.path(i).size(); j++)
-    {
-      varCoeff[i][j-1]=fusion.coefficient(i,j);
-      varIdx[i][j-1]=fusion.varIdx(i,j);
-    }
-    l1norm[i]=fusion.l1norm(i);
-    if(fusion.evolution()[i-1].first.size()!=0)
-        evoIdxAdd[i-1]=fusion.evolution()[i-1].first;
-    if(fusion.evolution()[i-1].second.size()!=0)
-        evoIdxDrop[i-1]=fusion.evolution()[i-1].second;
-  }
-
+  List res = List::create( Named("path")      =wrapPath(fusion.path())
+                         , Named("step")      =wrap(fusion.step())
+                         , Named("mu")        =wrap(fusion.mu())
+                         , Named("ignored")   =STK::wrap(fusion.toIgnore().cast<int>())
+                         , Named("error")     =wrap(fusion.msg_error())
+                         , Named("muX")       =STK::wrap(fusion.muX())
+                         , Named("rss")       =wrap(fusion.rss())
+                         , Named("timings")   =wrapTimings(fusion.timings())
+                         );
 #ifdef FUSION_DEBUG
   stk_cerr << _T("fusionmain done")<<endl;
 #endif
-  //t2=clock();
-  //cout<<"Temps extraction des données:"<<(double) (t2-t1)/CLOCKS_PER_SEC<<"s"<<endl;
-
-  return List::create( Named("l1norm")    =wrap(l1norm)
-                     , Named("lambda")    =wrap(fusion.lambda())
-                     , Named("varIdx")    =wrap(varIdx)
-                     , Named("varCoeff")  =wrap(varCoeff)
-                     , Named("step")      =wrap(step)
-                     , Named("evoDropIdx")=wrap(evoIdxDrop)
-                     , Named("evoAddIdx") =wrap(evoIdxAdd)
-                     , Named("mu")        =wrap(fusion.mu())
-                     , Named("ignored")   =STK::wrap(fusion.toIgnore().cast<int>())
-                     , Named("error")     =wrap(fusion.msg_error())
-                     , Named("muX")       =STK::wrap(fusion.muX())
-                     );
+  delete p_fusion;
+  if(sparseX) delete sparseX;
+  return res;
+
+}
 
+/*
+ * coefficients of a path at several values of l1norm or lambda
+ * @param stateBegin, varIdx, varCoeff, l1norm, lambda path in flat vectors (see wrapPath)
+ * @param index values of l1norm or lambda
+ * @param mode if true, index contains lambda values
+ * @return the coefficients in a CSC matrix of size p x length(index): the column offsets, the
+ * index of the variables and the coefficients
+ */
+RcppExport SEXP larscoefficientsmain( SEXP stateBegin, SEXP varIdx, SEXP varCoeff, SEXP l1norm, SEXP lambda
+                                    , SEXP index, SEXP mode)
+{
+  Path path( as<vector<int> >(stateBegin), as<vector<int> >(varIdx), as<vector<double> >(varCoeff)
+           , as<vector<double> >(l1norm), as<vector<double> >(lambda));
+  vector<int> colBegin, rowIdx;
+  vector<double> values;
+  path.coefficients(as<vector<double> >(index), as<bool>(mode), colBegin, rowIdx, values);
+  return List::create( Named("colBegin")=wrap(colBegin)
+                     , Named("varIdx")  =wrap(rowIdx)
+                     , Named("varCoeff")=wrap(values)
+                     );
 }
 
 RcppExport SEXP cvlarsmain( SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar
                           , SEXP maxStep, SEXP intercept, SEXP eps, SEXP nbFold
-                          , SEXP partition, SEXP index, SEXP mode)
+                          , SEXP partition, SEXP index, SEXP mode, SEXP storage, SEXP gram
+                          , SEXP nbRepeats, SEXP seed)
 {
 #ifdef CVLARS_DEBUG
   stk_cerr << _T("Entering cvlarsmain")<<endl;
@@ -216,17 +434,19 @@ RcppExport SEXP cvlarsmain( SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar
   //t1=clock();
   //convert parameters
   int p(as<int>(nbVar)), n(as<int>(nbIndiv));
-  int maxStepC(as<int>(maxStep)), nbFoldC(as<int>(nbFold));
+  int maxStepC(as<int>(maxStep)), nbFoldC(as<int>(nbFold)), nbRepeatsC(as<int>(nbRepeats));
+  unsigned long seedC = (unsigned long) as<double>(seed);
   bool interceptC = as<bool>(intercept);
-  bool modeLambda = as<bool>(mode);
+  bool modeLambda = as<bool>(mode), gramC = as<bool>(gram);
   STK::Real epsC(as<STK::Real>(eps));
+  std::string storageC = as<std::string>(storage);
 
   vector<double> indexC=as<vector<double> >(index);
   vector<int> partitionC=as<vector<int> >(partition);
 
-  STK::CArrayXX x(STK::Range(1,n), STK::Range(1,p));
+  STK::CArrayXX x;
   STK::CVectorX y(STK::Range(1,n));
-  convertToArray(data,x);
+  IDesign* design = createDesign(data,n,p,storageC,x);
   convertToVector(response,y);
   //t2=clock();
   //run algorithm
@@ -234,8 +454,10 @@ RcppExport SEXP cvlarsmain( SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar
 #ifdef CVLARS_DEBUG
   stk_cerr << _T("cvlarsmain. Creating Cvlars")<<endl;
 #endif
-  Cvlars cvlars(x,y,nbFoldC,indexC,modeLambda,maxStepC,interceptC,epsC);
+  Cvlars cvlars(*design,y,nbFoldC,indexC,modeLambda,maxStepC,interceptC,epsC);
   if(partitionC[0]!=-1) { cvlars.setPartition(partitionC);}
+  else { cvlars.setRepeats(nbRepeatsC, seedC);}
+  cvlars.setGram(gramC);
 
 #ifdef _OPENMP
   cvlars.run2();
@@ -252,6 +474,10 @@ RcppExport SEXP cvlarsmain( SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar
 #ifdef CVLARS_DEBUG
   stk_cerr << _T("cvlarsmain done")<<endl;
 #endif
-  return List::create( Named("cv")     =STK::wrap(cvlars.cv())
-                     , Named("cvError")=STK::wrap(cvlars.cvError()));
+  List res = List::create( Named("cv")       =STK::wrap(cvlars.cv())
+                         , Named("cvError")  =STK::wrap(cvlars.cvError())
+                         , Named("cvRepeats")=STK::wrap(cvlars.cvRepeats())
+                         , Named("timings")  =wrapTimings(cvlars.timings()));
+  delete design;
+  return res;
 }
@@ -6,7 +6,15 @@
 #include "lars/PathState.h"
 #include "lars/functions.h"
 #include "lars/Path.h"
+#include "lars/GramCache.h"
+#include "lars/Cholesky.h"
+#include "lars/QrFactor.h"
+#include "lars/LarsWorkspace.h"
+#include "lars/Timings.h"
+#include "lars/Design.h"
+#include "lars/MappedDesign.h"
 #include "lars/Lars.h"
+#include "lars/MultiLars.h"
 #include "lars/Cvlars.h"
 #include "lars/Fusion.h"
 
@@ -111,8 +119,11 @@ void print(STK::Array1D<Type> const& A, std::string const& name, std::string con
 #endif
 
 
-RcppExport SEXP larsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps);
+RcppExport SEXP larsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps, SEXP gram, SEXP cacheSize, SEXP cholesky, SEXP storage, SEXP validate, SEXP minLambda, SEXP maxActive, SEXP maxL1norm);
+RcppExport SEXP multilarsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP nbResponse, SEXP maxStep, SEXP intercept, SEXP eps, SEXP storage, SEXP minLambda, SEXP maxActive, SEXP maxL1norm);
+RcppExport SEXP larsfilemain(SEXP file, SEXP response, SEXP nbIndiv, SEXP type, SEXP offset, SEXP maxStep, SEXP intercept, SEXP eps, SEXP gram, SEXP cacheSize, SEXP cholesky, SEXP minLambda, SEXP maxActive, SEXP maxL1norm);
 RcppExport SEXP fusionmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps);
-RcppExport SEXP cvlarsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps, SEXP nbFold, SEXP partition, SEXP index, SEXP mode);
+RcppExport SEXP larscoefficientsmain(SEXP stateBegin, SEXP varIdx, SEXP varCoeff, SEXP l1norm, SEXP lambda, SEXP index, SEXP mode);
+RcppExport SEXP cvlarsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps, SEXP nbFold, SEXP partition, SEXP index, SEXP mode, SEXP storage, SEXP gram, SEXP nbRepeats, SEXP seed);
 
 #endif
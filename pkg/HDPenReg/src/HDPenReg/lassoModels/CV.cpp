@@ -34,6 +34,7 @@
 
 
 #include "CV.h"
+#include "../lars/functions.h"
 #include <cstdlib>
 #include <algorithm>
 
@@ -47,6 +48,7 @@ namespace HD
         , measure_(), cv_()
         , cvError_(), nbFolds_(0)
         , n_(0), p_(0)
+        , seed_(time(NULL))
   {
   }
   /*
@@ -68,6 +70,7 @@ namespace HD
                 , nbFolds_(nbFolds)
                 , n_(X.sizeRows())
                 , p_(X.sizeCols())
+                , seed_(time(NULL))
   {
     //create the partition
     partition();
@@ -78,15 +81,10 @@ namespace HD
    */
   void CV::partition()
   {
-    //fill the container with the index of folds
-    for(int i = 0 ; i< n_ ;i++)
-    {
-      partition_[i] = i%nbFolds_;
-      sizePartition_[i%nbFolds_]++;
-    }
-    //make a random rearrangement
-    srand(time(NULL));
-    random_shuffle(partition_.begin(),partition_.end());
+    sizePartition_.assign(nbFolds_, 0);
+    for(int i = 0 ; i< n_ ;i++) { sizePartition_[i%nbFolds_]++;}
+    //random rearrangement drawn with the counter based generator, without global state
+    randomPartition(n_, nbFolds_, seed_, 0, partition_);
   }
 
   /*initialize containers and create partition*/
@@ -153,29 +151,44 @@ void CV::subrun(int idxStartFold,int idxEndFold)
 
   for(int i = idxStartFold ; i <= idxEndFold ; i++)
   {
-    //fill the container
-    int index = 1;
-    int index2 = 1;
-    for(int j = 0; j < n_; j++)
-    {
-      if(partition_[j-1] != i)
-      {
-        yControl[index] = (*p_y_)[j];
-        XControl.row(index)=p_X_->row(j);
-
-        index++;
-      }
-      else
-      {
-        yTest[index2] = (*p_y_)[j];
-        XTest.row(index2)=p_X_->row(j);
-        index2++;
-      }
-    }
+    fillFold(i, XControl, yControl, XTest, yTest);
     runModel(i,XTest,yTest,&XControl,&yControl);
   }
 }
 
+/*
+ * fill the control and test containers of a fold
+ * @param idxFold index of the fold
+ * @param XControl, yControl control data
+ * @param XTest, yTest test data
+ */
+void CV::fillFold( int idxFold, STK::ArrayXX& XControl, STK::VectorX& yControl
+                 , STK::ArrayXX& XTest, STK::VectorX& yTest) const
+{
+  //index of the control and test individuals, computed once for all the columns
+  std::vector<int> rowsControl, rowsTest;
+  rowsControl.reserve(n_ - sizePartition_[idxFold]);
+  rowsTest.reserve(sizePartition_[idxFold]);
+  for(int i = 0; i < n_; i++)
+  {
+    if(partition_[i] != idxFold) { rowsControl.push_back(i);}
+    else { rowsTest.push_back(i);}
+  }
+  for(int i = 0; i < (int) rowsControl.size(); i++)
+    yControl[yControl.begin()+i] = (*p_y_)[p_y_->begin()+rowsControl[i]];
+  for(int i = 0; i < (int) rowsTest.size(); i++)
+    yTest[yTest.begin()+i] = (*p_y_)[p_y_->begin()+rowsTest[i]];
+  //copy column by column instead of row by row
+  for(int j = 0; j < p_; j++)
+  {
+    int jX = p_X_->beginCols()+j;
+    for(int i = 0; i < (int) rowsControl.size(); i++)
+      XControl(XControl.beginRows()+i, XControl.beginCols()+j) = (*p_X_)(p_X_->beginRows()+rowsControl[i], jX);
+    for(int i = 0; i < (int) rowsTest.size(); i++)
+      XTest(XTest.beginRows()+i, XTest.beginCols()+j) = (*p_X_)(p_X_->beginRows()+rowsTest[i], jX);
+  }
+}
+
 /*parallelized version of run*/
 void CV::run2()
  {
@@ -199,24 +212,7 @@ void CV::run2()
        STK::VectorX yControl( n_ - sizePartition_[i] );
        STK::ArrayXX XTest(sizePartition_[i], p_);
        STK::VectorX yTest(sizePartition_[i] );
-       //fill the container
-       int index = 0;
-       int index2 = 0;
-       for(int j = 0; j < n_; j++)
-       {
-         if(partition_[j] != i)
-         {
-           yControl[index] = (*p_y_)[j];
-           XControl.row(index)=p_X_->row(j);
-           index++;
-         }
-         else
-         {
-           yTest[index2] = (*p_y_)[j];
-           XTest.row(index2)=p_X_->row(j);
-           index2++;
-         }
-       }
+       fillFold(i, XControl, yControl, XTest, yTest);
 #ifdef HD_CVDEBUG
        std::cout << "Fold build. Call runModel\n";
 #endif
@@ -262,24 +258,7 @@ void CV::run3()
        STK::VectorX yControl( n_ - sizePartition_[i] );
        STK::ArrayXX XTest(sizePartition_[i], p_);
        STK::VectorX yTest(sizePartition_[i] );
-       //fill the container
-       int index = 1;
-       int index2 = 1;
-       for(int j = 0; j < n_; j++)
-       {
-         if(partition_[j] != i)
-         {
-           yControl[index] = (*p_y_)[j];
-           XControl.row(index)=p_X_->row(j);
-           index++;
-         }
-         else
-         {
-           yTest[index2] = (*p_y_)[j];
-           XTest.row(index2)=p_X_->row(j);
-           index2++;
-         }
-       }
+       fillFold(i, XControl, yControl, XTest, yTest);
 
        runModel(i,XTest,yTest,&XControl,&yControl);
      }
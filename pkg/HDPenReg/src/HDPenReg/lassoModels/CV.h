@@ -79,6 +79,8 @@ namespace HD
       inline void setNbFolds(int const& nbFolds) {nbFolds_ = nbFolds;}
       /**set the index to test*/
       inline void setIndex(std::vector<double> const& index) {index_ = index;}
+      /**set the seed of the random partition (used by initialize)*/
+      inline void setSeed(unsigned long seed) {seed_ = seed;}
 
       //getter
       /** @return return the prediction error for each index*/
@@ -100,6 +102,16 @@ namespace HD
        * @param idxEndFold index of the last fold
        */
       void subrun(int idxStartFold,int idxEndFold);
+      /**
+       * fill the control and test containers of a fold. X is stored by column, the containers
+       * are filled column by column. The folds are copies: the EM models work on a STK::ArrayXX,
+       * not on the views on the individuals of the lars library (RowSubsetDesign).
+       * @param idxFold index of the fold
+       * @param XControl, yControl control data, with n - sizePartition_[idxFold] rows
+       * @param XTest, yTest test data, with sizePartition_[idxFold] rows
+       */
+      void fillFold( int idxFold, STK::ArrayXX& XControl, STK::VectorX& yControl
+                   , STK::ArrayXX& XTest, STK::VectorX& yTest) const;
 
       /**
        * run model on all values of index for the given control data
@@ -134,6 +146,8 @@ namespace HD
       int n_;
       ///number of variables
       int p_;
+      ///seed of the generator of the partition
+      unsigned long seed_;
   };
 }
 
@@ -13,13 +13,16 @@ extern SEXP cvEMlasso(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP
 extern SEXP cvEMlogisticFusedLasso1D(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP cvEMlogisticFusedLasso2D(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP cvEMlogisticLasso(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
-extern SEXP cvlars(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP cvlars(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP EMfusedLasso(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP EMlassoC(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP EMlogisticFusedLasso(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP EMlogisticLasso(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP fusion(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
-extern SEXP lars(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP larscoefficients(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP lars(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP larsfile(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
+extern SEXP multilars(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 
 extern SEXP EMlassoMain(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
 extern SEXP EMlogisticLassoMain(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP);
@@ -40,13 +43,16 @@ static const R_CallMethodDef CallEntries[] = {
   {"cvEMlogisticFusedLasso1D", (DL_FUNC) &cvEMlogisticFusedLasso1D, 12},
   {"cvEMlogisticFusedLasso2D", (DL_FUNC) &cvEMlogisticFusedLasso2D, 11},
   {"cvEMlogisticLasso",        (DL_FUNC) &cvEMlogisticLasso,        10},
-  {"cvlars",                   (DL_FUNC) &cvlars,                   11},
+  {"cvlars",                   (DL_FUNC) &cvlars,                   15},
   {"EMfusedLasso",             (DL_FUNC) &EMfusedLasso,             10},
   {"EMlassoC",                  (DL_FUNC) &EMlassoC,                   9},
   {"EMlogisticFusedLasso",     (DL_FUNC) &EMlogisticFusedLasso,     10},
   {"EMlogisticLasso",          (DL_FUNC) &EMlogisticLasso,           9},
   {"fusion",                   (DL_FUNC) &fusion,                    7},
-  {"lars",                     (DL_FUNC) &lars,                      7},
+  {"lars",                     (DL_FUNC) &lars,                     15},
+  {"larscoefficients",         (DL_FUNC) &larscoefficients,          7},
+  {"larsfile",                 (DL_FUNC) &larsfile,                 14},
+  {"multilars",                (DL_FUNC) &multilars,                12},
   {"EMlassoMain",              (DL_FUNC) &EMlassoMain,               9},
   {"EMlogisticLassoMain",      (DL_FUNC) &EMlogisticLassoMain,       9},
   {"EMfusedLassoMain",         (DL_FUNC) &EMfusedLassoMain,         10},
@@ -1,11 +1,20 @@
 #include <Rcpp.h>
 #include "larsR.h"
 
-extern "C" SEXP lars(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps)
-{ return larsmain(data, response, nbIndiv, nbVar, maxStep, intercept, eps);}
+extern "C" SEXP lars(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps, SEXP gram, SEXP cacheSize, SEXP cholesky, SEXP storage, SEXP validate, SEXP minLambda, SEXP maxActive, SEXP maxL1norm)
+{ return larsmain(data, response, nbIndiv, nbVar, maxStep, intercept, eps, gram, cacheSize, cholesky, storage, validate, minLambda, maxActive, maxL1norm);}
+
+extern "C" SEXP multilars(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP nbResponse, SEXP maxStep, SEXP intercept, SEXP eps, SEXP storage, SEXP minLambda, SEXP maxActive, SEXP maxL1norm)
+{ return multilarsmain(data, response, nbIndiv, nbVar, nbResponse, maxStep, intercept, eps, storage, minLambda, maxActive, maxL1norm);}
+
+extern "C" SEXP larsfile(SEXP file, SEXP response, SEXP nbIndiv, SEXP type, SEXP offset, SEXP maxStep, SEXP intercept, SEXP eps, SEXP gram, SEXP cacheSize, SEXP cholesky, SEXP minLambda, SEXP maxActive, SEXP maxL1norm)
+{ return larsfilemain(file, response, nbIndiv, type, offset, maxStep, intercept, eps, gram, cacheSize, cholesky, minLambda, maxActive, maxL1norm);}
 
 extern "C"  SEXP fusion(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps)
 { return fusionmain(data, response, nbIndiv, nbVar, maxStep, intercept, eps);}
 
-extern "C"  SEXP cvlars(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps, SEXP nbFold, SEXP partition, SEXP index, SEXP mode)
-{ return cvlarsmain(data, response, nbIndiv, nbVar, maxStep, intercept, eps, nbFold, partition, index, mode);}
+extern "C"  SEXP larscoefficients(SEXP stateBegin, SEXP varIdx, SEXP varCoeff, SEXP l1norm, SEXP lambda, SEXP index, SEXP mode)
+{ return larscoefficientsmain(stateBegin, varIdx, varCoeff, l1norm, lambda, index, mode);}
+
+extern "C"  SEXP cvlars(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps, SEXP nbFold, SEXP partition, SEXP index, SEXP mode, SEXP storage, SEXP gram, SEXP nbRepeats, SEXP seed)
+{ return cvlarsmain(data, response, nbIndiv, nbVar, maxStep, intercept, eps, nbFold, partition, index, mode, storage, gram, nbRepeats, seed);}
@@ -11,9 +11,12 @@ extern "C"
 {
 #endif
 
-SEXP larsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps);
-SEXP cvlarsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps, SEXP nbFold, SEXP partition, SEXP index, SEXP mode);
+SEXP larsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps, SEXP gram, SEXP cacheSize, SEXP cholesky, SEXP storage, SEXP validate, SEXP minLambda, SEXP maxActive, SEXP maxL1norm);
+SEXP multilarsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP nbResponse, SEXP maxStep, SEXP intercept, SEXP eps, SEXP storage, SEXP minLambda, SEXP maxActive, SEXP maxL1norm);
+SEXP larsfilemain(SEXP file, SEXP response, SEXP nbIndiv, SEXP type, SEXP offset, SEXP maxStep, SEXP intercept, SEXP eps, SEXP gram, SEXP cacheSize, SEXP cholesky, SEXP minLambda, SEXP maxActive, SEXP maxL1norm);
+SEXP cvlarsmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps, SEXP nbFold, SEXP partition, SEXP index, SEXP mode, SEXP storage, SEXP gram, SEXP nbRepeats, SEXP seed);
 SEXP fusionmain(SEXP data, SEXP response, SEXP nbIndiv, SEXP nbVar, SEXP maxStep, SEXP intercept, SEXP eps);
+SEXP larscoefficientsmain(SEXP stateBegin, SEXP varIdx, SEXP varCoeff, SEXP l1norm, SEXP lambda, SEXP index, SEXP mode);
 
 #ifdef __cplusplus
 }